@@ -0,0 +1,76 @@
+#include "AdaaTables.h"
+
+namespace
+{
+    constexpr int kSubdivisions = 4; // Simpson sub-intervals per grid step
+
+    float curveSample(int mode, float x, float driveNorm)
+    {
+        return SaturationKernels::clampValue(SaturationKernels::processSample(mode, x, driveNorm), -1.5f, 1.5f);
+    }
+}
+
+AdaaTables::AdaaTables()
+{
+    constexpr int numCurves = SaturationKernels::numModes * kNumDrivePoints;
+    constexpr double step = 1.0 / kPointsPerUnit;
+    constexpr double fineStep = step / kSubdivisions;
+    constexpr int numFine = (kNumPoints - 1) * kSubdivisions + 1;
+
+    data.resize(static_cast<size_t>(numCurves) * kNumPoints * 2);
+    curves.resize(static_cast<size_t>(numCurves));
+
+    std::vector<double> fine(static_cast<size_t>(numFine));
+
+    for (int mode = 0; mode < SaturationKernels::numModes; ++mode)
+    {
+        for (int d = 0; d < kNumDrivePoints; ++d)
+        {
+            const float driveNorm = static_cast<float>(d) / static_cast<float>(kNumDrivePoints - 1);
+            const int curveIndex = mode * kNumDrivePoints + d;
+            double* points = data.data() + static_cast<size_t>(curveIndex) * kNumPoints * 2;
+
+            // Sample the curve on the fine grid, then integrate each grid step
+            // with composite Simpson (handles the curves' kinks well enough)
+            for (int k = 0; k < numFine; ++k)
+                fine[static_cast<size_t>(k)] = curveSample(mode, static_cast<float>(-kRange + k * fineStep), driveNorm);
+
+            double integral = 0.0;
+            for (int i = 0; i < kNumPoints; ++i)
+            {
+                const auto* f = fine.data() + static_cast<size_t>(i) * kSubdivisions;
+                points[2 * i] = integral;
+                points[2 * i + 1] = f[0];
+
+                if (i < kNumPoints - 1)
+                    integral += fineStep / 3.0 * (f[0] + 4.0 * f[1] + 2.0 * f[2] + 4.0 * f[3] + f[4]);
+            }
+
+            auto& curve = curves[static_cast<size_t>(curveIndex)];
+            curve.points = points;
+            curve.numPoints = kNumPoints;
+            curve.xMin = -kRange;
+            curve.xMax = kRange;
+            curve.step = step;
+            curve.invStep = 1.0 / step;
+        }
+    }
+}
+
+SharedAdaaTables::SharedAdaaTables()
+{
+    builder.addJob([this]
+    {
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        storage = std::make_unique<AdaaTables>();
+        tables.store(storage.get(), std::memory_order_release);
+
+        DBG("ADAA tables built in " + juce::String(juce::Time::getMillisecondCounterHiRes() - start, 1) + " ms");
+    });
+}
+
+size_t SharedAdaaTables::getSizeInBytes() const
+{
+    const auto* built = get();
+    return built != nullptr ? built->getSizeInBytes() : 0;
+}
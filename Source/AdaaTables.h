@@ -0,0 +1,76 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "DspKernels.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * Antiderivative tables for first-order ADAA of the saturation curves.
+ *
+ * The curves (including the final +-1.5 clamp) have no closed-form
+ * antiderivative, so F(x) = integral of f is tabulated in double precision on
+ * a uniform grid over [-kRange, kRange], together with f itself, and read back
+ * with cubic Hermite interpolation. Outside the range the curves are flat
+ * (clamped or saturated), so F is extended linearly.
+ *
+ * The curves also depend on driveNorm; tables are built for kNumDrivePoints
+ * drive values and the kernel blends the two neighbours linearly, which is
+ * the exact antiderivative of the blended curve.
+ *
+ * About 3.3 MB in total, built once and shared by all instances
+ * (SharedAdaaTables).
+ */
+class AdaaTables
+{
+public:
+    static constexpr double kRange = 32.0;
+    static constexpr int kPointsPerUnit = 64;
+    static constexpr int kNumPoints = static_cast<int>(2.0 * kRange) * kPointsPerUnit + 1;
+    static constexpr int kNumDrivePoints = 17;
+
+    AdaaTables();
+
+    /** Table for a mode at drive grid index (0 .. kNumDrivePoints - 1). */
+    const DspKernels::AdaaCurve& getCurve(int mode, int driveIndex) const
+    {
+        return curves[static_cast<size_t>(mode * kNumDrivePoints + driveIndex)];
+    }
+
+    size_t getSizeInBytes() const { return data.size() * sizeof(double); }
+
+private:
+    std::vector<double> data;                 // interleaved F, f per grid point
+    std::vector<DspKernels::AdaaCurve> curves;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AdaaTables)
+};
+
+/**
+ * The process-wide AdaaTables, held through juce::SharedResourcePointer.
+ *
+ * Building them takes a few tens of milliseconds, so it happens on a
+ * background thread when the first holder is created, and the result is
+ * published through an atomic pointer.
+ */
+class SharedAdaaTables
+{
+public:
+    SharedAdaaTables();
+
+    /** nullptr while the tables are still being built. Safe on the audio thread. */
+    const AdaaTables* get() const { return tables.load(std::memory_order_acquire); }
+
+    size_t getSizeInBytes() const;
+
+private:
+    std::unique_ptr<AdaaTables> storage;
+    std::atomic<const AdaaTables*> tables { nullptr };
+
+    // Declared last so it is destroyed (and waits for the build) first
+    juce::ThreadPool builder { 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedAdaaTables)
+};
@@ -0,0 +1,446 @@
+#include "ChannelStrip.h"
+#include "KernelDispatch.h"
+
+namespace
+{
+    constexpr double kModeFadeSeconds = 0.02; // 20ms mode crossfade
+    constexpr double kOversamplingFadeSeconds = 0.02;
+}
+
+ChannelStrip::ChannelStrip()
+    : kernels(KernelDispatch::getKernels())
+{
+    for (int stages = 0; stages <= kOversamplingStages; ++stages)
+        oversampling[stages] = std::make_unique<juce::dsp::Oversampling<float>>(
+            1, static_cast<size_t>(stages), juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR);
+
+    // Configure compressor for drum "pressure"
+    compressor.setThreshold(-20.0f);
+    compressor.setRatio(4.0f);
+    compressor.setAttack(5.0f);
+    compressor.setRelease(100.0f);
+
+    // Configure tone filters
+    toneFilterLow.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+    toneFilterHigh.setType(juce::dsp::StateVariableTPTFilterType::highpass);
+}
+
+void ChannelStrip::prepare(double sampleRate, int maxChunkSize)
+{
+    maxChunk = maxChunkSize;
+
+    // Fade length counted in oversampled samples
+    fadeBaseLength = juce::jmax(1, juce::roundToInt(kModeFadeSeconds * sampleRate));
+    fadeLength = fadeBaseLength << activeStages;
+    fadeScale = 1.0f / static_cast<float>(fadeLength);
+    switchFadeLength = juce::jmax(1, juce::roundToInt(kOversamplingFadeSeconds * sampleRate));
+
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = static_cast<juce::uint32>(maxChunkSize);
+    spec.numChannels = 1;
+
+    for (auto& os : oversampling)
+        os->initProcessing(spec.maximumBlockSize);
+
+    // The oversamplers' latency is known once they're initialised
+    float maxLatency = 0.0f;
+    for (int stages = 0; stages <= kOversamplingStages; ++stages)
+        maxLatency = juce::jmax(maxLatency, getPathLatency(stages, true));
+    paddedLatency = static_cast<int>(std::ceil(maxLatency));
+
+    for (auto& pad : latencyPad)
+        pad.prepare(1, paddedLatency);
+
+    compressor.prepare(spec);
+    toneFilterLow.prepare(spec);
+    toneFilterHigh.prepare(spec);
+    driveEnvelope.prepare(sampleRate, 1, maxChunkSize, 1 << kOversamplingStages);
+    driveEnvelope.setOversamplingFactor(1 << activeStages);
+
+    crushedBuffer.assign(static_cast<size_t>(maxChunkSize), 0.0f);
+    highBuffer.assign(static_cast<size_t>(maxChunkSize), 0.0f);
+    switchBuffer.assign(static_cast<size_t>(maxChunkSize), 0.0f);
+    switchEnvelope.assign(static_cast<size_t>(maxChunkSize) << kOversamplingStages, 0.0f);
+    staticEnvelope.assign(static_cast<size_t>(maxChunkSize) << kOversamplingStages, 0.0f);
+
+    reset();
+}
+
+void ChannelStrip::reset()
+{
+    for (auto& os : oversampling)
+        os->reset();
+    for (auto& pad : latencyPad)
+        pad.reset();
+    compressor.reset();
+    toneFilterLow.reset();
+    toneFilterHigh.reset();
+    driveEnvelope.reset();
+    transientState = {};
+    adaaState = {};
+    fadeRemaining = 0;
+    switchFadeRemaining = 0;
+    hasMode = false;
+}
+
+void ChannelStrip::copyStateFrom(const ChannelStrip& other)
+{
+    jassert(maxChunk == other.maxChunk);
+
+    // Same sizes on both sides, so none of these copies allocate
+    compressor = other.compressor;
+    toneFilterLow = other.toneFilterLow;
+    toneFilterHigh = other.toneFilterHigh;
+    driveEnvelope = other.driveEnvelope;
+    transientState = other.transientState;
+
+    params = other.params;
+    hasMode = other.hasMode;
+    fadeFromMode = other.fadeFromMode;
+    fadeRemaining = other.fadeRemaining;
+    fadeLength = other.fadeLength;
+    fadeScale = other.fadeScale;
+
+    activeStages = other.activeStages;
+    switchFromStages = other.switchFromStages;
+    switchFromAdaa = other.switchFromAdaa;
+    switchFadeRemaining = other.switchFadeRemaining;
+    switchAdaaState = other.switchAdaaState;
+
+    useAdaa = other.useAdaa;
+    adaaState = other.adaaState;
+    adaaLower = other.adaaLower;
+    adaaUpper = other.adaaUpper;
+    fadeLower = other.fadeLower;
+    fadeUpper = other.fadeUpper;
+    adaaBlend = other.adaaBlend;
+    transientKernel = other.transientKernel;
+    saturationKernel = other.saturationKernel;
+
+    for (auto& os : oversampling)
+        os->reset();
+    for (int stages = 0; stages <= kOversamplingStages; ++stages)
+    {
+        latencyPad[stages].setDelay(other.latencyPad[stages].getDelay());
+        latencyPad[stages].reset();
+    }
+}
+
+size_t ChannelStrip::getBufferBytes() const
+{
+    const auto chunk = static_cast<size_t>(maxChunk);
+    size_t numFloats = crushedBuffer.size() + highBuffer.size() + switchBuffer.size() + switchEnvelope.size()
+                       + staticEnvelope.size();
+
+    // Envelope ramp + one up-sampled buffer per stage of every oversampler
+    numFloats += chunk * (size_t(1) << kOversamplingStages);
+    for (size_t stages = 1; stages <= static_cast<size_t>(kOversamplingStages); ++stages)
+        for (size_t stage = 1; stage <= stages; ++stage)
+            numFloats += chunk * (size_t(1) << stage);
+
+    size_t bytes = numFloats * sizeof(float);
+    for (const auto& pad : latencyPad)
+        bytes += pad.getBufferBytes();
+    return bytes;
+}
+
+void ChannelStrip::setOversamplingStages(int stages)
+{
+    stages = juce::jlimit(0, kOversamplingStages, stages);
+    if (stages == activeStages)
+        return;
+
+    const int oldFactor = 1 << activeStages;
+    const int newFactor = 1 << stages;
+
+    if (hasMode)
+    {
+        // Fade from the factor that is currently (mostly) audible. The old
+        // oversampler keeps its state, so its output continues seamlessly
+        switchFromStages = activeStages;
+        switchFromAdaa = useAdaa;
+        switchAdaaState = adaaState;
+        switchFadeRemaining = switchFadeLength;
+    }
+
+    activeStages = stages;
+
+    // The newly active filters hold stale state from their last use
+    getOversampling().reset();
+    latencyPad[activeStages].reset();
+    driveEnvelope.setOversamplingFactor(newFactor);
+
+    fadeLength = fadeBaseLength << activeStages;
+    fadeScale = 1.0f / static_cast<float>(fadeLength);
+    fadeRemaining = fadeRemaining * newFactor / oldFactor;
+}
+
+float ChannelStrip::getPathLatency(int stages, bool adaa) const
+{
+    // First-order ADAA delays by half a sample at the processing rate
+    const float adaaDelay = adaa ? 0.5f / static_cast<float>(1 << stages) : 0.0f;
+    return oversampling[stages]->getLatencyInSamples() + adaaDelay;
+}
+
+void ChannelStrip::setParameters(const Parameters& newParameters)
+{
+    if (hasMode && newParameters.mode != params.mode)
+    {
+        // Fade from the mode that is currently (mostly) audible. A change
+        // during a fade restarts it from the mode that was fading in
+        fadeFromMode = params.mode;
+        fadeRemaining = fadeLength;
+    }
+
+    params = newParameters;
+    hasMode = true;
+
+    setOversamplingStages(params.oversamplingStages);
+
+    const bool adaaAvailable = params.adaa && params.adaaTables != nullptr;
+    if (adaaAvailable != useAdaa)
+    {
+        adaaState = {};
+        useAdaa = adaaAvailable;
+    }
+
+    // A factor that is fading out keeps the padding it had
+    latencyPad[activeStages].setDelay(static_cast<float>(paddedLatency) - getPathLatency(activeStages, useAdaa));
+
+    if (params.adaaTables != nullptr && (useAdaa || (switchFadeRemaining > 0 && switchFromAdaa)))
+    {
+        // Drive position between the tables' grid points
+        const double drivePos = juce::jlimit(0.0, 1.0, static_cast<double>(params.driveNorm)) * (AdaaTables::kNumDrivePoints - 1);
+        const int lower = juce::jmin(static_cast<int>(drivePos), AdaaTables::kNumDrivePoints - 2);
+        const int mode = juce::jlimit(0, SaturationKernels::numModes - 1, params.mode);
+        const int fromMode = juce::jlimit(0, SaturationKernels::numModes - 1, fadeFromMode);
+
+        adaaBlend = drivePos - lower;
+        adaaLower = &params.adaaTables->getCurve(mode, lower);
+        adaaUpper = &params.adaaTables->getCurve(mode, lower + 1);
+        fadeLower = &params.adaaTables->getCurve(fromMode, lower);
+        fadeUpper = &params.adaaTables->getCurve(fromMode, lower + 1);
+    }
+
+    // Pick the specialised kernels for this block
+    transientKernel = kernels.transient[std::abs(params.attackNorm) > 0.02f ? 1 : 0]
+                                       [std::abs(params.sustainNorm) > 0.02f ? 1 : 0];
+    saturationKernel = kernels.saturation[juce::jlimit(0, SaturationKernels::numModes - 1, params.mode)];
+
+    if (params.pressureNorm > 0.01f)
+    {
+        // Aggressive compression settings
+        compressor.setThreshold(-30.0f - params.pressureNorm * 20.0f);          // -30 to -50 dB
+        compressor.setRatio(4.0f + params.pressureNorm * 16.0f);                // 4:1 to 20:1
+        compressor.setAttack(0.5f + (1.0f - params.pressureNorm) * 5.0f);       // Fast attack
+        compressor.setRelease(50.0f + (1.0f - params.sustainNorm) * 150.0f);    // Release affected by sustain
+    }
+
+    if (params.toneNorm < -0.05f)
+    {
+        // DARK: Low pass filter, down to ~500Hz at -100
+        const float cutoff = 18000.0f * std::pow(10.0f, params.toneNorm * 1.5f);
+        toneFilterLow.setCutoffFrequency(std::max(300.0f, cutoff));
+    }
+    else if (params.toneNorm > 0.05f)
+    {
+        // BRIGHT: High frequency boost via parallel high-pass
+        toneFilterHigh.setCutoffFrequency(2000.0f + params.toneNorm * 4000.0f);
+    }
+}
+
+void ChannelStrip::saturateCrossfade(float* data, const float* envelope, int numSamples,
+                                     float baseDriveGain, float driveNorm)
+{
+    // Mode change in progress: equal-power crossfade from the old curve to
+    // the new one. Only here do both kernels run
+    const float envDepth = driveNorm * 10.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float totalDrive = baseDriveGain * (1.0f + envelope[i] * envDepth);
+        const float x = data[i] * totalDrive;
+
+        const float t = 1.0f - static_cast<float>(fadeRemaining) * fadeScale;
+        const float angle = t * juce::MathConstants<float>::halfPi;
+        float fromShaped, toShaped;
+
+        if (useAdaa)
+        {
+            const double xPrev = adaaState.xPrev;
+            fromShaped = static_cast<float>(DspKernels::adaaSample(*fadeLower, *fadeUpper, adaaBlend, x, xPrev));
+            toShaped = static_cast<float>(DspKernels::adaaSample(*adaaLower, *adaaUpper, adaaBlend, x, xPrev));
+            adaaState.xPrev = x;
+        }
+        else
+        {
+            fromShaped = SaturationKernels::processSample(fadeFromMode, x, driveNorm);
+            toShaped = SaturationKernels::processSample(params.mode, x, driveNorm);
+        }
+
+        data[i] = std::clamp(fromShaped * std::cos(angle) + toShaped * std::sin(angle), -1.5f, 1.5f);
+        --fadeRemaining;
+    }
+}
+
+void ChannelStrip::processSwitchFade(float* data, int numSamples, float baseDriveGain, float driveNorm)
+{
+    // Oversampling change in progress: run the previous factor's saturation
+    // on the copy of the input and fade it out under the new one. Both paths
+    // carry the same (correlated) signal, so the fade is linear
+    float* old = switchBuffer.data();
+
+    auto& os = *oversampling[switchFromStages];
+    juce::dsp::AudioBlock<float> oldBlock(&old, 1, static_cast<size_t>(numSamples));
+    auto oversampledBlock = os.processSamplesUp(oldBlock);
+    auto* oversampled = oversampledBlock.getChannelPointer(0);
+    const int numOversampled = static_cast<int>(oversampledBlock.getNumSamples());
+
+    // The drive envelope is rendered at the new factor; resample it to the old one
+    const int newFactor = 1 << activeStages;
+    const int oldFactor = 1 << switchFromStages;
+    const float* newEnvelope = getDriveModulation();
+    float* envelope = switchEnvelope.data();
+    for (int i = 0; i < numOversampled; ++i)
+        envelope[i] = newEnvelope[i * newFactor / oldFactor];
+
+    if (switchFromAdaa && adaaLower != nullptr)
+        kernels.adaa(oversampled, envelope, numOversampled, baseDriveGain, driveNorm,
+                     *adaaLower, *adaaUpper, adaaBlend, switchAdaaState);
+    else
+        saturationKernel(oversampled, envelope, numOversampled, baseDriveGain, driveNorm);
+
+    os.processSamplesDown(oldBlock);
+    latencyPad[switchFromStages].process(0, old, old, numSamples);
+
+    const float scale = 1.0f / static_cast<float>(switchFadeLength);
+    for (int i = 0; i < numSamples && switchFadeRemaining > 0; ++i)
+    {
+        const float t = 1.0f - static_cast<float>(switchFadeRemaining) * scale;
+        data[i] = old[i] + (data[i] - old[i]) * t;
+        --switchFadeRemaining;
+    }
+}
+
+void ChannelStrip::process(float* data, int numSamples)
+{
+    for (int start = 0; start < numSamples; start += maxChunk)
+        processChunk(data + start, juce::jmin(maxChunk, numSamples - start));
+}
+
+void ChannelStrip::processChunk(float* data, int numSamples)
+{
+    const float driveNorm = params.driveNorm;
+    const float pressureNorm = params.pressureNorm;
+
+    juce::dsp::AudioBlock<float> block(&data, 1, static_cast<size_t>(numSamples));
+
+    // Drive modulation envelope (control rate, interpolated to the oversampled rate)
+    driveEnvelope.process(&data, 1, numSamples);
+
+    // =========================================================================
+    // STAGE 1: TRANSIENT SHAPING (Attack & Sustain)
+    // =========================================================================
+    if (params.doTransientShaping)
+        transientKernel(data, numSamples, transientState, params.attackNorm, params.sustainNorm);
+
+    // =========================================================================
+    // STAGE 2: SATURATION (Mode-dependent character)
+    // Oversampled for clean harmonics (and/or ADAA at the lower factors)
+    // =========================================================================
+    // Input of the outgoing factor's path while an oversampling switch fades
+    const bool switchFading = switchFadeRemaining > 0;
+    if (switchFading)
+        std::copy(data, data + numSamples, switchBuffer.data());
+
+    auto& os = getOversampling();
+    auto oversampledBlock = os.processSamplesUp(block);
+
+    // Dynamic drive: base gain + envelope-following boost
+    // With transient shaping on, this makes the saturation "breathe" with the
+    // drums; with it off the drive stays static (the default sound). The
+    // envelope is updated every ControlEnvelope::kControlInterval samples and
+    // ramped per oversampled sample, so it tracks the same at any buffer size
+    const float baseDriveGain = 1.0f + driveNorm * 15.0f;
+    auto* oversampled = oversampledBlock.getChannelPointer(0);
+    const float* envelope = getDriveModulation();
+    const int numOversampled = static_cast<int>(oversampledBlock.getNumSamples());
+    int done = 0;
+
+    if (fadeRemaining > 0)
+    {
+        done = juce::jmin(fadeRemaining, numOversampled);
+        saturateCrossfade(oversampled, envelope, done, baseDriveGain, driveNorm);
+    }
+
+    if (useAdaa)
+        kernels.adaa(oversampled + done, envelope + done, numOversampled - done, baseDriveGain, driveNorm,
+                     *adaaLower, *adaaUpper, adaaBlend, adaaState);
+    else
+        saturationKernel(oversampled + done, envelope + done, numOversampled - done, baseDriveGain, driveNorm);
+
+    os.processSamplesDown(block);
+    latencyPad[activeStages].process(0, data, data, numSamples);
+
+    if (switchFading)
+        processSwitchFade(data, numSamples, baseDriveGain, driveNorm);
+
+    // Makeup gain (compensate for saturation level changes)
+    const float satMakeup = 1.0f / (1.0f + driveNorm * 0.8f);
+    juce::FloatVectorOperations::multiply(data, satMakeup, numSamples);
+
+    // =========================================================================
+    // STAGE 3: PRESSURE (Parallel Compression)
+    // NY-style: blend crushed signal with original for punch + sustain
+    // =========================================================================
+    if (pressureNorm > 0.01f)
+    {
+        // Parallel copy for compression
+        float* crushed = crushedBuffer.data();
+        std::copy(data, data + numSamples, crushed);
+
+        juce::dsp::AudioBlock<float> crushedBlock(&crushed, 1, static_cast<size_t>(numSamples));
+        juce::dsp::ProcessContextReplacing<float> compContext(crushedBlock);
+        compressor.process(compContext);
+
+        // Makeup gain on crushed signal
+        crushedBlock.multiplyBy(1.0f + pressureNorm * 4.0f);
+
+        // Blend: more pressure = more crushed signal
+        const float crushMix = pressureNorm * 0.7f;
+        const float cleanMix = 1.0f - crushMix * 0.3f;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            data[i] = data[i] * cleanMix + crushed[i] * crushMix;
+        }
+    }
+
+    // =========================================================================
+    // STAGE 4: TONE (Frequency Shaping)
+    // =========================================================================
+    if (params.toneNorm < -0.05f)
+    {
+        // DARK: Low pass filter
+        juce::dsp::ProcessContextReplacing<float> ctx(block);
+        toneFilterLow.process(ctx);
+    }
+    else if (params.toneNorm > 0.05f)
+    {
+        // BRIGHT: High frequency boost via parallel high-pass
+        float* high = highBuffer.data();
+        std::copy(data, data + numSamples, high);
+
+        juce::dsp::AudioBlock<float> highBlock(&high, 1, static_cast<size_t>(numSamples));
+        juce::dsp::ProcessContextReplacing<float> ctx(highBlock);
+        toneFilterHigh.process(ctx);
+
+        // Add highs back with boost
+        const float highBoost = params.toneNorm * 2.0f;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            data[i] += high[i] * highBoost;
+        }
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "AdaaTables.h"
+#include "ControlEnvelope.h"
+#include "DspKernels.h"
+#include "LatencyDelay.h"
+
+#include <memory>
+
+/**
+ * The per-channel part of the DRIVE chain: transient shaping, oversampled
+ * saturation, parallel compression and tone (stages 1-4).
+ *
+ * A strip owns mono instances of every DSP object it uses and shares no
+ * state with the other channel's strip, so two strips can run on different
+ * threads. Stereo-coupled stages (width, mix, auto gain, ceiling) stay in
+ * DriveEngine.
+ *
+ * The saturation can run at 1x, 2x or 4x. With ADAA enabled the curves are
+ * evaluated through their antiderivatives (AdaaTables), which keeps aliasing
+ * down at the lower factors for a fraction of the CPU. Switching the factor
+ * crossfades from the old one, so it can change while audio is playing
+ * (see QualityGovernor). Every factor's output is delayed to the slowest
+ * one's latency, so the strip's latency never changes with the factor.
+ */
+class ChannelStrip
+{
+public:
+    static constexpr int kOversamplingStages = 2; // up to 4x
+
+    /** Per-host-block settings, normalised like the processor's parameters. */
+    struct Parameters
+    {
+        float driveNorm = 0.0f;     // 0-1
+        float pressureNorm = 0.0f;  // 0-1
+        float attackNorm = 0.0f;    // -1 to +1
+        float sustainNorm = 0.0f;   // -1 to +1
+        float toneNorm = 0.0f;      // -1 to +1
+        int mode = 0;
+        bool doTransientShaping = false;
+        int oversamplingStages = kOversamplingStages;  // 0 = 1x, 1 = 2x, 2 = 4x
+        bool adaa = false;
+        const AdaaTables* adaaTables = nullptr;        // nullptr until built, ADAA is skipped
+    };
+
+    ChannelStrip();
+
+    /** maxChunkSize is the most process() hands to the DSP objects at once. */
+    void prepare(double sampleRate, int maxChunkSize);
+    void reset();
+
+    /** Updates the DSP objects for the next block. */
+    void setParameters(const Parameters& newParameters);
+
+    /** Processes one channel in place, in chunks of at most maxChunkSize samples. */
+    void process(float* data, int numSamples);
+
+    /**
+     * Takes over another strip's state, for the engine's dual-mono fast
+     * path: an idle strip resumes exactly where the running one is. Both
+     * must be prepared alike. The oversamplers' filter state can't be copied,
+     * so they restart from silence; the caller crossfades over their settling.
+     */
+    void copyStateFrom(const ChannelStrip& other);
+
+    /** Switches the saturation's oversampling factor (0 .. kOversamplingStages). */
+    void setOversamplingStages(int stages);
+
+    /**
+     * Base-rate latency, whole samples: the slowest factor's (with ADAA),
+     * rounded up. The same at every factor and ADAA setting.
+     */
+    float getLatencyInSamples() const { return static_cast<float>(paddedLatency); }
+
+    /** Largest latency any setting can report (the same as getLatencyInSamples()). */
+    float getMaxLatencyInSamples() const { return static_cast<float>(paddedLatency); }
+
+    /** Bytes of per-strip buffers (for the processor's memory report). */
+    size_t getBufferBytes() const;
+
+private:
+    void processChunk(float* data, int numSamples);
+    void saturateCrossfade(float* data, const float* envelope, int numSamples, float baseDriveGain, float driveNorm);
+    void processSwitchFade(float* data, int numSamples, float baseDriveGain, float driveNorm);
+
+    /**
+     * Per oversampled sample drive modulation: the envelope with transient
+     * shaping on, zero (static drive) with it off.
+     */
+    const float* getDriveModulation() const
+    {
+        return params.doTransientShaping ? driveEnvelope.getOversampledEnvelope(0) : staticEnvelope.data();
+    }
+
+    /** Latency of one factor's oversampling (and ADAA) path, before padding. */
+    float getPathLatency(int stages, bool adaa) const;
+
+    Parameters params;
+    int maxChunk = 0;
+
+    juce::dsp::Oversampling<float>& getOversampling() const { return *oversampling[activeStages]; }
+
+    // One oversampler per factor (1x is a pass-through stage) so switching
+    // never allocates
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversampling[kOversamplingStages + 1];
+    int activeStages = kOversamplingStages;
+
+    // Per factor: delays its output up to paddedLatency
+    LatencyDelay latencyPad[kOversamplingStages + 1];
+    int paddedLatency = 0;
+    juce::dsp::Compressor<float> compressor;
+    juce::dsp::StateVariableTPTFilter<float> toneFilterLow;
+    juce::dsp::StateVariableTPTFilter<float> toneFilterHigh;
+
+    // Control-rate envelope driving the saturation amount. It always follows
+    // the input, so it is current when transient shaping turns on
+    ControlEnvelope driveEnvelope;
+
+    // Mode crossfade (oversampled samples)
+    int fadeBaseLength = 1;  // base-rate samples
+    int fadeLength = 1;
+    int fadeRemaining = 0;
+    float fadeScale = 1.0f;
+    int fadeFromMode = 0;
+    bool hasMode = false;  // no fade into the first block after a reset
+
+    // Oversampling switch crossfade (base-rate samples). The previous factor
+    // keeps running on a copy of the input until the fade is done
+    int switchFadeLength = 1;
+    int switchFadeRemaining = 0;
+    int switchFromStages = 0;
+    bool switchFromAdaa = false;
+    DspKernels::AdaaState switchAdaaState;
+
+    // Persistent envelope followers for transient detection
+    DspKernels::TransientState transientState;
+
+    // Specialised kernels for the current block, from the CPU's ISA level
+    // table (see DspKernels, KernelDispatch)
+    const DspKernels::KernelTable& kernels;
+    DspKernels::TransientKernel transientKernel = kernels.transient[0][0];
+    DspKernels::SaturationKernel saturationKernel = kernels.saturation[0];
+
+    // ADAA curves for the current block: the two drive grid neighbours and
+    // the blend between them, for the current mode and the one fading out
+    bool useAdaa = false;
+    DspKernels::AdaaState adaaState;
+    const DspKernels::AdaaCurve* adaaLower = nullptr;
+    const DspKernels::AdaaCurve* adaaUpper = nullptr;
+    const DspKernels::AdaaCurve* fadeLower = nullptr;
+    const DspKernels::AdaaCurve* fadeUpper = nullptr;
+    double adaaBlend = 0.0;
+
+    // Preallocated scratch (one chunk each)
+    std::vector<float> crushedBuffer;
+    std::vector<float> highBuffer;
+    std::vector<float> switchBuffer;
+    std::vector<float> switchEnvelope;  // at the highest factor
+    std::vector<float> staticEnvelope;  // zeros, at the highest factor
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelStrip)
+};
@@ -0,0 +1,86 @@
+#include "CoalescedSliderAttachment.h"
+#include "TraceRecorder.h"
+
+CoalescedSliderAttachment::CoalescedSliderAttachment(juce::RangedAudioParameter& parameterIn,
+                                                     juce::WebSliderRelay& relayIn,
+                                                     juce::UndoManager* undoManager)
+    : relay(relayIn),
+      parameter(parameterIn),
+      attachment(parameterIn, [this](float newValue) { relay.setValue(newValue); }, undoManager)
+{
+    sendInitialUpdate();
+    relay.addListener(this);
+}
+
+CoalescedSliderAttachment::~CoalescedSliderAttachment()
+{
+    relay.removeListener(this);
+
+    // Don't lose the last value of a drag, or leave the host mid-gesture
+    flush();
+    if (inGesture)
+        attachment.endGesture();
+}
+
+void CoalescedSliderAttachment::flush()
+{
+    if (!hasPendingValue)
+        return;
+
+    DRIVE_TRACE_SCOPE("relay flush", "message");
+    hasPendingValue = false;
+
+    // ParameterAttachment skips the write if the value hasn't changed
+    if (inGesture)
+        attachment.setValueAsPartOfGesture(pendingValue);
+    else
+        attachment.setValueAsCompleteGesture(pendingValue);
+}
+
+void CoalescedSliderAttachment::sendInitialUpdate()
+{
+    // Same properties event as juce::WebSliderParameterAttachment, which the
+    // SliderState in juce-bridge.ts reads
+    const auto range = parameter.getNormalisableRange();
+
+    auto* object = new juce::DynamicObject();
+    object->setProperty("eventType", "propertiesChanged");
+    object->setProperty("start", range.start);
+    object->setProperty("end", range.end);
+    object->setProperty("skew", range.skew);
+    object->setProperty("name", parameter.getName(100));
+    object->setProperty("label", parameter.getLabel());
+    object->setProperty("numSteps", parameter.getNumSteps());
+    object->setProperty("interval", range.interval);
+    object->setProperty("parameterIndex", parameter.getParameterIndex());
+    relay.emitEvent(juce::var(object));
+
+    attachment.sendInitialUpdate();
+}
+
+void CoalescedSliderAttachment::sliderValueChanged(juce::WebSliderRelay*)
+{
+    pendingValue = relay.getValue();
+    hasPendingValue = true;
+}
+
+void CoalescedSliderAttachment::sliderDragStarted(juce::WebSliderRelay*)
+{
+    DRIVE_TRACE_SCOPE("relay gesture begin", "message");
+    flush();
+    attachment.beginGesture();
+    inGesture = true;
+}
+
+void CoalescedSliderAttachment::sliderDragEnded(juce::WebSliderRelay*)
+{
+    DRIVE_TRACE_SCOPE("relay gesture end", "message");
+    flush();
+    attachment.endGesture();
+    inGesture = false;
+}
+
+void CoalescedSliderAttachment::initialUpdateRequested(juce::WebSliderRelay*)
+{
+    sendInitialUpdate();
+}
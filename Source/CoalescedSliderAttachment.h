@@ -0,0 +1,48 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_gui_extra/juce_gui_extra.h>
+
+/**
+ * Connects a WebSliderRelay to a parameter like
+ * juce::WebSliderParameterAttachment, but coalesces the value stream coming
+ * from the web UI.
+ *
+ * Values arriving from the relay are only remembered. flush(), called from
+ * the editor's timer, writes the latest one to the parameter, so a drag
+ * reaches the host as at most one parameter write (and one automation point)
+ * per flush instead of one per pointer event. Gesture begin/end are passed
+ * straight through: a pending value is written before either, so the host
+ * sees begin, values, end in order.
+ *
+ * Parameter changes from the host (automation, presets) go to the relay as
+ * before, through juce::ParameterAttachment's async update.
+ */
+class CoalescedSliderAttachment : private juce::WebSliderRelay::Listener
+{
+public:
+    CoalescedSliderAttachment(juce::RangedAudioParameter& parameter, juce::WebSliderRelay& relay,
+                              juce::UndoManager* undoManager);
+    ~CoalescedSliderAttachment() override;
+
+    /** Writes the pending value, if any. Message thread only. */
+    void flush();
+
+private:
+    void sendInitialUpdate();
+
+    void sliderValueChanged(juce::WebSliderRelay*) override;
+    void sliderDragStarted(juce::WebSliderRelay*) override;
+    void sliderDragEnded(juce::WebSliderRelay*) override;
+    void initialUpdateRequested(juce::WebSliderRelay*) override;
+
+    juce::WebSliderRelay& relay;
+    juce::RangedAudioParameter& parameter;
+    juce::ParameterAttachment attachment;
+
+    float pendingValue = 0.0f;  // denormalised
+    bool hasPendingValue = false;
+    bool inGesture = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CoalescedSliderAttachment)
+};
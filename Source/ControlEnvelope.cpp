@@ -0,0 +1,113 @@
+#include "ControlEnvelope.h"
+
+void ControlEnvelope::prepare(double newSampleRate, int numChannels, int maxBlockSize, int maxOversamplingFactor)
+{
+    sampleRate = newSampleRate;
+    channels = juce::jlimit(1, kMaxChannels, numChannels);
+    factor = maxFactor = juce::jmax(1, maxOversamplingFactor);
+    stepScale = 1.0f / static_cast<float>(kControlInterval * factor);
+
+    for (auto& r : ramp)
+        r.assign(static_cast<size_t>(maxBlockSize * factor), 0.0f);
+
+    updateCoefficients();
+    reset();
+}
+
+void ControlEnvelope::reset()
+{
+    for (int ch = 0; ch < kMaxChannels; ++ch)
+    {
+        envelope[ch] = 0.0f;
+        framePeak[ch] = 0.0f;
+        current[ch] = 0.0f;
+        step[ch] = 0.0f;
+    }
+    phase = 0;
+}
+
+void ControlEnvelope::setOversamplingFactor(int newFactor)
+{
+    jassert(newFactor >= 1 && newFactor <= maxFactor);
+    newFactor = juce::jlimit(1, maxFactor, newFactor);
+
+    if (newFactor == factor)
+        return;
+
+    // Same slope per base-rate sample, so the ramp still lands on the
+    // envelope at the next tick
+    const float rescale = static_cast<float>(factor) / static_cast<float>(newFactor);
+    for (auto& s : step)
+        s *= rescale;
+
+    factor = newFactor;
+    stepScale = 1.0f / static_cast<float>(kControlInterval * factor);
+}
+
+void ControlEnvelope::setReleaseTime(float seconds)
+{
+    releaseTime = juce::jmax(0.001f, seconds);
+    updateCoefficients();
+}
+
+void ControlEnvelope::updateCoefficients()
+{
+    const double controlPeriod = kControlInterval / sampleRate;
+    releaseCoeff = static_cast<float>(1.0 - std::exp(-controlPeriod / releaseTime));
+}
+
+void ControlEnvelope::process(const float* const* channelData, int numChannelsIn, int numSamples)
+{
+    const int numChannels = juce::jmin(channels, numChannelsIn);
+    jassert(static_cast<size_t>(numSamples * factor) <= ramp[0].size());
+
+    int pos = 0;
+
+    while (pos < numSamples)
+    {
+        // Work up to the end of the current control frame
+        const int todo = juce::jmin(numSamples - pos, kControlInterval - phase);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(channelData[ch] + pos, todo);
+            framePeak[ch] = juce::jmax(framePeak[ch], -range.getStart(), range.getEnd());
+
+            float* out = ramp[static_cast<size_t>(ch)].data() + pos * factor;
+            float value = current[ch];
+            const float inc = step[ch];
+
+            for (int i = 0; i < todo * factor; ++i)
+            {
+                value += inc;
+                out[i] = value;
+            }
+
+            current[ch] = value;
+        }
+
+        phase += todo;
+        pos += todo;
+
+        if (phase == kControlInterval)
+        {
+            // Control tick: update the envelope from the finished frame and
+            // aim the ramp at it for the next frame
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                // The finished ramp ends exactly on the previous value
+                current[ch] = envelope[ch];
+
+                if (framePeak[ch] > envelope[ch])
+                    envelope[ch] = framePeak[ch];
+                else
+                    envelope[ch] += (framePeak[ch] - envelope[ch]) * releaseCoeff;
+
+                step[ch] = (envelope[ch] - current[ch]) * stepScale;
+                framePeak[ch] = 0.0f;
+            }
+
+            phase = 0;
+        }
+    }
+}
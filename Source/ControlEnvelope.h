@@ -0,0 +1,62 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <vector>
+
+/**
+ * Peak envelope computed at a fixed control rate and interpolated up to the
+ * oversampled rate, for modulating the saturation stage.
+ *
+ * Every kControlInterval base-rate samples the envelope takes the frame's
+ * peak (instant attack, release time constant in seconds). Between control
+ * ticks the output ramps linearly towards the latest value, one step per
+ * oversampled sample. Ticks are counted across process() calls, so the
+ * modulation is the same at any host or chunk size. The ramp trails the input
+ * by one control period (kControlInterval samples).
+ */
+class ControlEnvelope
+{
+public:
+    static constexpr int kControlInterval = 16; // base-rate samples per control tick
+
+    /** Ramp buffers are sized for maxOversamplingFactor, which is also the initial factor. */
+    void prepare(double sampleRate, int numChannels, int maxBlockSize, int maxOversamplingFactor);
+    void reset();
+
+    /** Changes the output rate without disturbing the envelope (up to the prepared maximum). */
+    void setOversamplingFactor(int newFactor);
+
+    /** Release time constant in seconds. */
+    void setReleaseTime(float seconds);
+
+    /**
+     * Follows numSamples base-rate samples and renders the interpolated
+     * envelope for them (numSamples * oversamplingFactor values per channel).
+     */
+    void process(const float* const* channelData, int numChannels, int numSamples);
+
+    /** Envelope rendered by the last process() call, at the oversampled rate. */
+    const float* getOversampledEnvelope(int channel) const { return ramp[static_cast<size_t>(channel)].data(); }
+
+private:
+    void updateCoefficients();
+
+    static constexpr int kMaxChannels = 2;
+
+    double sampleRate = 44100.0;
+    int channels = 2;
+    int factor = 1;
+    int maxFactor = 1;
+    float releaseTime = 0.011f;   // matches the transient detector's fast envelope
+    float releaseCoeff = 0.0f;    // one-pole coefficient per control tick
+    float stepScale = 1.0f;       // 1 / (kControlInterval * factor)
+
+    float envelope[kMaxChannels] = { 0.0f, 0.0f };  // value at the last tick
+    float framePeak[kMaxChannels] = { 0.0f, 0.0f }; // peak of the current frame
+    float current[kMaxChannels] = { 0.0f, 0.0f };   // interpolated output
+    float step[kMaxChannels] = { 0.0f, 0.0f };      // per oversampled sample
+    int phase = 0;                                  // position within the control frame
+
+    std::vector<float> ramp[kMaxChannels];
+};
@@ -0,0 +1,139 @@
+#include "DriveDSP.h"
+#include "DriveEngine.h"
+
+#include <new>
+
+struct DriveDsp
+{
+    DriveEngine engine;
+};
+
+namespace
+{
+    DriveEngine::Parameters toEngine(const DriveDspParameters& p)
+    {
+        DriveEngine::Parameters e;
+        e.drive = p.drive;
+        e.pressure = p.pressure;
+        e.tone = p.tone;
+        e.mix = p.mix;
+        e.output = p.output;
+        e.mode = juce::jlimit(0, 2, p.mode);
+        e.attack = p.attack;
+        e.sustain = p.sustain;
+        e.sidechainHp = p.sidechainHp;
+        e.autoGain = p.autoGain != 0;
+        e.stereoWidth = p.stereoWidth;
+        e.bypass = p.bypass != 0;
+        e.ceilingMode = juce::jlimit(0, 2, p.ceilingMode);
+        e.ceiling = p.ceiling;
+        e.oversampling = juce::jlimit(0, ChannelStrip::kOversamplingStages, p.oversampling);
+        e.adaa = p.adaa != 0;
+        e.adaptiveQuality = p.adaptiveQuality != 0;
+        return e;
+    }
+
+    DriveDspParameters fromEngine(const DriveEngine::Parameters& e)
+    {
+        DriveDspParameters p;
+        p.drive = e.drive;
+        p.pressure = e.pressure;
+        p.tone = e.tone;
+        p.mix = e.mix;
+        p.output = e.output;
+        p.mode = e.mode;
+        p.attack = e.attack;
+        p.sustain = e.sustain;
+        p.sidechainHp = e.sidechainHp;
+        p.autoGain = e.autoGain ? 1 : 0;
+        p.stereoWidth = e.stereoWidth;
+        p.bypass = e.bypass ? 1 : 0;
+        p.ceilingMode = e.ceilingMode;
+        p.ceiling = e.ceiling;
+        p.oversampling = e.oversampling;
+        p.adaa = e.adaa ? 1 : 0;
+        p.adaptiveQuality = e.adaptiveQuality ? 1 : 0;
+        return p;
+    }
+}
+
+DriveDsp* drive_dsp_create(void)
+{
+    return new (std::nothrow) DriveDsp();
+}
+
+void drive_dsp_destroy(DriveDsp* dsp)
+{
+    delete dsp;
+}
+
+void drive_dsp_default_parameters(DriveDspParameters* params)
+{
+    if (params != nullptr)
+        *params = fromEngine(DriveEngine::Parameters());
+}
+
+int drive_dsp_prepare(DriveDsp* dsp, double sampleRate, int numChannels, int nonRealtime)
+{
+    if (dsp == nullptr || sampleRate <= 0.0 || numChannels < 1 || numChannels > DriveEngine::kMaxChannels)
+        return -1;
+
+    DriveEngine::ProcessSetup setup;
+    setup.sampleRate = sampleRate;
+    setup.numChannels = numChannels;
+    setup.nonRealtime = nonRealtime != 0;
+    dsp->engine.prepare(setup);
+    return 0;
+}
+
+void drive_dsp_set_parameters(DriveDsp* dsp, const DriveDspParameters* params)
+{
+    if (dsp != nullptr && params != nullptr)
+        dsp->engine.setParameters(toEngine(*params));
+}
+
+void drive_dsp_get_parameters(const DriveDsp* dsp, DriveDspParameters* params)
+{
+    if (dsp != nullptr && params != nullptr)
+        *params = fromEngine(dsp->engine.getParameters());
+}
+
+void drive_dsp_process(DriveDsp* dsp, float* const* channels, int numChannels, int numSamples)
+{
+    if (dsp != nullptr && channels != nullptr)
+        dsp->engine.process(channels, numChannels, numSamples);
+}
+
+void drive_dsp_reset(DriveDsp* dsp)
+{
+    if (dsp != nullptr)
+        dsp->engine.reset();
+}
+
+int drive_dsp_get_latency(const DriveDsp* dsp)
+{
+    return dsp != nullptr ? dsp->engine.getLatencyInSamples() : 0;
+}
+
+int drive_dsp_get_state(const DriveDsp* dsp, void* dest, int destSize)
+{
+    if (dsp == nullptr)
+        return 0;
+
+    juce::MemoryBlock state;
+    dsp->engine.getState(state);
+
+    const int size = static_cast<int>(state.getSize());
+    if (dest != nullptr && destSize >= size)
+        state.copyTo(dest, 0, state.getSize());
+
+    return size;
+}
+
+int drive_dsp_set_state(DriveDsp* dsp, const void* data, int sizeInBytes)
+{
+    if (dsp == nullptr)
+        return -1;
+
+    return dsp->engine.setState(data, sizeInBytes) ? 0 : -1;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+/*
+ * C interface to the DRIVE DSP core (Drive_DSP library), for hosts that
+ * can't use the C++ API directly, e.g. the render service's node runtime.
+ *
+ * One DriveDsp is one DriveEngine. Audio is planar float, processed in place
+ * in the caller's buffers. Parameter values use the same units as the plugin
+ * (see ParameterIDs::Ranges) and the state blob is the plugin's binary state,
+ * so sessions and presets move between the plugin and a render node as-is.
+ *
+ * drive_dsp_prepare, drive_dsp_set_parameters, drive_dsp_process,
+ * drive_dsp_reset and drive_dsp_set_state must not be called concurrently
+ * on the same instance. Separate instances are independent.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+ #define DRIVE_DSP_API
+#else
+ #define DRIVE_DSP_API __attribute__((visibility("default")))
+#endif
+
+typedef struct DriveDsp DriveDsp;
+
+typedef struct DriveDspParameters
+{
+    float drive;         /* 0 to 100 % */
+    float pressure;      /* 0 to 100 % */
+    float tone;          /* -100 to +100 */
+    float mix;           /* 0 to 100 % */
+    float output;        /* -24 to +12 dB */
+    int mode;            /* 0 = Tube, 1 = Tape, 2 = Transistor */
+    float attack;        /* -100 to +100 */
+    float sustain;       /* -100 to +100 */
+    float sidechainHp;   /* 20 to 500 Hz */
+    int autoGain;        /* 0 or 1 */
+    float stereoWidth;   /* 0 to 200 % */
+    int bypass;          /* 0 or 1 */
+    int ceilingMode;     /* 0 = Off, 1 = Clip, 2 = Limit */
+    float ceiling;       /* -12 to 0 dBTP */
+    int oversampling;    /* 0 = 1x, 1 = 2x, 2 = 4x */
+    int adaa;            /* 0 or 1 */
+    int adaptiveQuality; /* 0 or 1: lower oversampling under CPU load and at high sample rates */
+} DriveDspParameters;
+
+/** Returns NULL on failure. */
+DRIVE_DSP_API DriveDsp* drive_dsp_create(void);
+DRIVE_DSP_API void drive_dsp_destroy(DriveDsp* dsp);
+
+/** Fills params with the plugin's defaults. */
+DRIVE_DSP_API void drive_dsp_default_parameters(DriveDspParameters* params);
+
+/**
+ * Allocates for processing. numChannels is 1 or 2; nonRealtime = 1 lets long
+ * blocks run the channels on separate threads. Returns 0 on success.
+ */
+DRIVE_DSP_API int drive_dsp_prepare(DriveDsp* dsp, double sampleRate, int numChannels, int nonRealtime);
+
+DRIVE_DSP_API void drive_dsp_set_parameters(DriveDsp* dsp, const DriveDspParameters* params);
+DRIVE_DSP_API void drive_dsp_get_parameters(const DriveDsp* dsp, DriveDspParameters* params);
+
+/** Processes numSamples of each channel in place. Any block length is accepted. */
+DRIVE_DSP_API void drive_dsp_process(DriveDsp* dsp, float* const* channels, int numChannels, int numSamples);
+
+DRIVE_DSP_API void drive_dsp_reset(DriveDsp* dsp);
+
+/**
+ * Delay in samples, for the caller's delay compensation. Fixed by
+ * drive_dsp_prepare(): no parameter changes it, so it can be read right
+ * after preparing (and before or after drive_dsp_set_parameters()).
+ */
+DRIVE_DSP_API int drive_dsp_get_latency(const DriveDsp* dsp);
+
+/**
+ * Writes the state blob into dest if destSize is large enough. Returns the
+ * blob's size either way, so call with dest = NULL to ask for it.
+ */
+DRIVE_DSP_API int drive_dsp_get_state(const DriveDsp* dsp, void* dest, int destSize);
+
+/** Restores a state blob. Returns 0 on success, -1 if the data isn't a DRIVE state. */
+DRIVE_DSP_API int drive_dsp_set_state(DriveDsp* dsp, const void* data, int sizeInBytes);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,716 @@
+#include "DriveEngine.h"
+#include "SignalSanitizer.h"
+
+#include <algorithm>
+
+// Runs channel 1's strip on the shared offline pool while the calling thread
+// runs channel 0's
+class DriveEngine::StripJob : public juce::ThreadPoolJob
+{
+public:
+    StripJob() : juce::ThreadPoolJob("DRIVE channel strip") {}
+
+    JobStatus runJob() override
+    {
+        // Worker threads don't inherit the host thread's FTZ/DAZ flags
+        juce::ScopedNoDenormals noDenormals;
+        DRIVE_TRACE_SCOPE("strip (channel 1)", "worker");
+        strip->process(data, numSamples);
+        return jobHasFinished;
+    }
+
+    ChannelStrip* strip = nullptr;
+    float* data = nullptr;
+    int numSamples = 0;
+};
+
+DriveEngine::Parameters DriveEngine::Parameters::fromStateValues(const StateSerializer::Values& values)
+{
+    const auto value = [&values](int index) { return values[static_cast<size_t>(index)]; };
+    const auto choice = [&value](int index, int maxValue) { return juce::jlimit(0, maxValue, juce::roundToInt(value(index))); };
+    const auto toggle = [&value](int index) { return value(index) > 0.5f; };
+
+    // Same order as ParameterIDs::stateOrder
+    Parameters p;
+    p.drive = value(0);
+    p.pressure = value(1);
+    p.tone = value(2);
+    p.mix = value(3);
+    p.output = value(4);
+    p.mode = choice(5, 2);
+    p.attack = value(6);
+    p.sustain = value(7);
+    p.sidechainHp = value(8);
+    p.autoGain = toggle(9);
+    p.stereoWidth = value(10);
+    p.bypass = toggle(11);
+    p.ceilingMode = choice(12, 2);
+    p.ceiling = value(13);
+    p.oversampling = choice(14, ChannelStrip::kOversamplingStages);
+    p.adaa = toggle(15);
+    p.adaptiveQuality = toggle(16);
+    return p;
+}
+
+StateSerializer::Values DriveEngine::Parameters::toStateValues() const
+{
+    static_assert(ParameterIDs::numStateParameters == 17, "Keep Parameters in step with ParameterIDs::stateOrder");
+
+    return { drive, pressure, tone, mix, output,
+             static_cast<float>(mode), attack, sustain, sidechainHp,
+             autoGain ? 1.0f : 0.0f, stereoWidth, bypass ? 1.0f : 0.0f,
+             static_cast<float>(ceilingMode), ceiling,
+             static_cast<float>(oversampling), adaa ? 1.0f : 0.0f,
+             adaptiveQuality ? 1.0f : 0.0f };
+}
+
+DriveEngine::DriveEngine()
+{
+    stripJob = std::make_unique<StripJob>();
+}
+
+DriveEngine::~DriveEngine() = default;
+
+void DriveEngine::prepare(const ProcessSetup& newSetup)
+{
+    setup = newSetup;
+    setup.numChannels = juce::jlimit(1, kMaxChannels, setup.numChannels);
+    setup.internalBlockSize = juce::jlimit(kMinInternalBlockSize, kMaxInternalBlockSize, setup.internalBlockSize);
+
+    // A pending parameter transition completes immediately
+    finishTransition();
+    transitionLength = juce::jmax(1, juce::roundToInt(kTransitionSeconds * setup.sampleRate));
+
+    // DSP objects only ever see one internal chunk, so any block size is safe
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = setup.sampleRate;
+    spec.maximumBlockSize = static_cast<juce::uint32>(setup.internalBlockSize);
+    spec.numChannels = static_cast<juce::uint32>(setup.numChannels);
+
+    // Offline renders run the channel strips over whole passes of
+    // kOfflinePassSize samples on separate threads, so the dry copy has to
+    // hold a full pass
+    passSize = setup.nonRealtime ? juce::jmax(setup.internalBlockSize, kOfflinePassSize) : setup.internalBlockSize;
+    dryBuffer.setSize(setup.numChannels, passSize);
+
+    // Adaptive quality starts from the top tier for the new rate
+    governor.prepare(setup.sampleRate, setup.internalBlockSize);
+    const auto tier = governor.getTier(params.oversampling, params.adaa, params.adaptiveQuality);
+
+    for (auto& strip : strips)
+    {
+        strip.prepare(setup.sampleRate, setup.internalBlockSize);
+        strip.setOversamplingStages(tier.oversamplingStages);
+    }
+
+    dualMonoHoldSamples = juce::jmax(1, juce::roundToInt(kDualMonoHoldSeconds * setup.sampleRate));
+    dualMonoStep = 1.0f / static_cast<float>(juce::jmax(1.0, kDualMonoFadeSeconds * setup.sampleRate));
+
+    outputGain.prepare(spec);
+    ceilingStage.prepare(spec);
+
+    // The strips' latency is the same at every quality tier and the
+    // ceiling's in every mode, so both dry paths are fixed
+    const float stripLatency = strips[0].getLatencyInSamples();
+    mixDelay.prepare(setup.numChannels, static_cast<int>(std::ceil(stripLatency)));
+    mixDelay.setDelay(stripLatency);
+    delayedDryBuffer.setSize(setup.numChannels, setup.internalBlockSize);
+
+    softBypass.setBypassed(params.bypass);
+    softBypass.prepare(setup.sampleRate, setup.numChannels, getLatencyInSamples(), setup.internalBlockSize);
+    softBypass.setDelay(getLatencyInSamples());
+    bypassIdle = false;
+
+    inputLoudness.prepare(setup.sampleRate);
+    outputLoudness.prepare(setup.sampleRate);
+    inputLoudness.setTimeConstant(kLoudnessTimeConstant);
+    outputLoudness.setTimeConstant(kLoudnessTimeConstant);
+    inputMeter.prepare(setup.numChannels, setup.internalBlockSize);
+    outputMeter.prepare(setup.numChannels, setup.internalBlockSize);
+    autoGainSmoothed.reset(setup.sampleRate, kAutoGainRampSeconds);
+    autoGainSmoothed.setCurrentAndTargetValue(1.0f);
+
+    // Envelope follower coefficient - SLOWER release to catch kick drums properly
+    // Kicks have energy spread over ~50-100ms, so we need slower release
+    envelopeCoeff = std::exp(-1.0f / (static_cast<float>(setup.sampleRate) * 0.12f)); // 120ms release
+}
+
+void DriveEngine::reset()
+{
+    resetDspState();
+    softBypass.reset();
+    bypassIdle = false;
+    finishTransition();
+}
+
+void DriveEngine::setParameters(const Parameters& newParameters)
+{
+    if (transitionRemaining > 0)
+        transitionTarget = newParameters;
+    else
+        params = newParameters;
+}
+
+void DriveEngine::transitionToParameters(const Parameters& newParameters)
+{
+    if (!hasProcessed)
+    {
+        transitionRemaining = 0;
+        params = newParameters;
+        return;
+    }
+
+    if (newParameters.toStateValues() == getParameters().toStateValues())
+        return;
+
+    // A new target mid-glide starts from wherever the glide has got to
+    transitionStart = params;
+    transitionTarget = newParameters;
+    transitionRemaining = transitionLength;
+}
+
+void DriveEngine::finishTransition()
+{
+    if (transitionRemaining > 0)
+        params = transitionTarget;
+
+    transitionRemaining = 0;
+    hasProcessed = false;
+}
+
+void DriveEngine::advanceTransition(int numSamples)
+{
+    transitionRemaining = juce::jmax(0, transitionRemaining - numSamples);
+    if (transitionRemaining == 0)
+    {
+        params = transitionTarget;
+        return;
+    }
+
+    const float t = 1.0f - static_cast<float>(transitionRemaining) / static_cast<float>(transitionLength);
+    const auto glide = [t](float from, float to) { return from + (to - from) * t; };
+    const auto& from = transitionStart;
+    const auto& to = transitionTarget;
+
+    // Choices and switches take the target's value straight away
+    params = to;
+    params.drive = glide(from.drive, to.drive);
+    params.pressure = glide(from.pressure, to.pressure);
+    params.tone = glide(from.tone, to.tone);
+    params.mix = glide(from.mix, to.mix);
+    params.output = glide(from.output, to.output);
+    params.attack = glide(from.attack, to.attack);
+    params.sustain = glide(from.sustain, to.sustain);
+    params.sidechainHp = glide(from.sidechainHp, to.sidechainHp);
+    params.stereoWidth = glide(from.stereoWidth, to.stereoWidth);
+    params.ceiling = glide(from.ceiling, to.ceiling);
+}
+
+int DriveEngine::getLatencyInSamples() const
+{
+    return juce::roundToInt(strips[0].getLatencyInSamples() + ceilingStage.getLatencyInSamples());
+}
+
+void DriveEngine::getState(juce::MemoryBlock& destData) const
+{
+    StateSerializer::writeBinary(getParameters().toStateValues(), destData);
+}
+
+bool DriveEngine::setState(const void* data, int sizeInBytes)
+{
+    StateSerializer::DecodedState state;
+    state.values = Parameters().toStateValues();
+
+    if (!StateSerializer::decodeBinary(data, sizeInBytes, state))
+        return false;
+
+    transitionToParameters(Parameters::fromStateValues(state.values));
+    return true;
+}
+
+void DriveEngine::process(float* const* channels, int numChannelsIn, int numSamples)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    const int numChannels = juce::jmin(numChannelsIn, kMaxChannels);
+    if (numChannels <= 0 || numSamples <= 0)
+        return;
+
+    // =========================================================================
+    // METERING
+    // One fused pass per channel at each meter point, accumulated over the
+    // whole host block (also when a glide splits it into chunks below). The
+    // input meter runs on the dry copy of each chunk, and also feeds auto gain
+    // =========================================================================
+    const bool meterTruePeak = truePeakMetering.load(std::memory_order_relaxed);
+    inputMeter.setTruePeakEnabled(meterTruePeak);
+    outputMeter.setTruePeakEnabled(meterTruePeak);
+    inputMeter.beginBlock();
+    outputMeter.beginBlock();
+
+    // A parameter transition glides one internal chunk at a time, so a large
+    // host block doesn't turn it into one step. The rest of the block goes
+    // through in one call once the glide is done
+    if (transitionRemaining > 0 && numSamples > setup.internalBlockSize)
+    {
+        float* chunk[kMaxChannels];
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int remaining = numSamples - start;
+            const int chunkSamples = transitionRemaining > 0 ? juce::jmin(setup.internalBlockSize, remaining) : remaining;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                chunk[ch] = channels[ch] + start;
+
+            processBlock(chunk, numChannels, chunkSamples);
+            start += chunkSamples;
+        }
+    }
+    else
+    {
+        processBlock(channels, numChannels, numSamples);
+    }
+
+    // Fully bypassed, the meters were cleared and stay at zero
+    if (!bypassIdle)
+        publishMeters();
+}
+
+void DriveEngine::processBlock(float* const* channels, int numChannels, int numSamples)
+{
+    // Refers to the caller's channels, no copy
+    juce::AudioBuffer<float> buffer(channels, numChannels, numSamples);
+
+    if (transitionRemaining > 0)
+        advanceTransition(numSamples);
+    hasProcessed = true;
+
+    // =========================================================================
+    // INPUT SANITIZER
+    // NaN/Inf from upstream would poison every filter and envelope state, so
+    // they're flushed before anything (including the meters) sees them
+    // =========================================================================
+    {
+        DRIVE_TRACE_SCOPE("sanitize", "audio");
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = buffer.getWritePointer(ch);
+            if (SignalSanitizer::needsSanitizing(data, numSamples))
+            {
+                const auto counts = SignalSanitizer::sanitize(data, numSamples);
+                sanitizedNonFinite.fetch_add(static_cast<juce::uint32>(counts.nonFinite), std::memory_order_relaxed);
+                sanitizedDenormals.fetch_add(static_cast<juce::uint32>(counts.denormals), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // =========================================================================
+    // BYPASS
+    // Fades to the input delayed by the (fixed) reported latency, so
+    // bypassing never moves the audio in time. Fully bypassed, nothing but
+    // that delay runs
+    // =========================================================================
+    softBypass.setBypassed(params.bypass);
+
+    if (softBypass.isIdle())
+    {
+        DRIVE_TRACE_SCOPE("bypass", "audio");
+        softBypass.processIdle(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+        if (!bypassIdle)
+            clearMeters();
+
+        // Nothing processed is audible, so a transition has nothing to glide
+        bypassIdle = true;
+        if (transitionRemaining > 0)
+        {
+            params = transitionTarget;
+            transitionRemaining = 0;
+        }
+        return;
+    }
+
+    if (bypassIdle)
+    {
+        // The stages have been idle: resume from clean state, under the fade
+        resetDspState();
+        bypassIdle = false;
+    }
+
+    // Feeds the adaptive quality governor. Idle bypassed blocks aren't
+    // timed, they would pull its steady-state load towards zero
+    juce::AudioProcessLoadMeasurer::ScopedTimer loadTimer(governor.getLoadMeasurer(), numSamples);
+
+    // =========================================================================
+    // NORMALIZE PARAMETERS (once per block, shared by all chunks)
+    // =========================================================================
+    ChannelStrip::Parameters stripParams;
+    stripParams.driveNorm = params.drive / 100.0f;          // 0-1
+    stripParams.pressureNorm = params.pressure / 100.0f;    // 0-1
+    stripParams.attackNorm = params.attack / 100.0f;        // -1 to +1
+    stripParams.sustainNorm = params.sustain / 100.0f;      // -1 to +1
+    stripParams.toneNorm = params.tone / 100.0f;            // -1 to +1
+    stripParams.mode = params.mode;
+    stripParams.doTransientShaping = std::abs(stripParams.attackNorm) > 0.02f || std::abs(stripParams.sustainNorm) > 0.02f;
+
+    // Oversampling/ADAA tier: the user's setting, or lower with adaptive
+    // quality (never in offline renders)
+    const bool adaptive = params.adaptiveQuality && !setup.nonRealtime;
+    governor.update(params.oversampling, adaptive, numSamples);
+    const auto tier = governor.getTier(params.oversampling, params.adaa, adaptive);
+    stripParams.oversamplingStages = tier.oversamplingStages;
+    stripParams.adaa = tier.adaa;
+    activeOversamplingStages.store(tier.oversamplingStages, std::memory_order_relaxed);
+    activeAdaa.store(tier.adaa, std::memory_order_relaxed);
+    qualityReduced.store(tier.oversamplingStages < params.oversampling, std::memory_order_relaxed);
+    stripParams.adaaTables = adaaTables->get();
+
+    CoupledParameters coupled;
+    coupled.mixNorm = params.mix / 100.0f;                  // 0-1
+    coupled.widthNorm = params.stereoWidth / 100.0f;        // 0-2
+    coupled.doWidth = numChannels == 2 && std::abs(params.stereoWidth - 100.0f) > 1.0f;
+    coupled.autoGain = params.autoGain;
+    coupled.ceilingMode = static_cast<TruePeakLimiter::Mode>(params.ceilingMode);
+    coupled.ceilingGain = juce::Decibels::decibelsToGain(params.ceiling);
+
+    // Per-block DSP setup
+    for (auto& strip : strips)
+        strip.setParameters(stripParams);
+
+    outputGain.setGainDecibels(params.output);
+
+    if (params.autoGain && !autoGainWasOn)
+    {
+        // Start tracking fresh rather than from stale levels
+        inputLoudness.reset();
+        outputLoudness.reset();
+    }
+    autoGainWasOn = params.autoGain;
+
+    // =========================================================================
+    // PROCESS IN PASSES
+    // Per-channel stages (1-4) run over a pass, then the stereo-coupled
+    // stages (5-8) run over the same samples. Inside both, every DSP object
+    // works on fixed internalBlockSize chunks while they are hot in cache,
+    // whatever block size the caller sends. Realtime passes are one chunk
+    // long; offline passes are longer and the channels run on separate threads
+    // =========================================================================
+    const int internalBlockSize = setup.internalBlockSize;
+    const int numStrips = juce::jmin(numChannels, dryBuffer.getNumChannels());
+    const bool parallel = setup.nonRealtime && numStrips > 1 && passSize > internalBlockSize;
+    const int samplesPerPass = parallel ? passSize : internalBlockSize;
+
+    // Identical channels (mono sources on stereo tracks) only need one strip
+    const bool runRightStrip = updateDualMono(buffer, numStrips, numSamples);
+    const int stripsToRun = runRightStrip ? numStrips : 1;
+
+    for (int start = 0; start < numSamples; start += samplesPerPass)
+    {
+        const int passSamples = juce::jmin(samplesPerPass, numSamples - start);
+
+        // Dry copy for the mix and the auto-gain reference
+        for (int ch = 0; ch < numStrips; ++ch)
+            dryBuffer.copyFrom(ch, 0, buffer, ch, start, passSamples);
+
+        {
+            DRIVE_TRACE_SCOPE("strips", "audio");
+
+            if (parallel && stripsToRun > 1)
+                processStripsInParallel(buffer, start, passSamples);
+            else
+                for (int ch = 0; ch < stripsToRun; ++ch)
+                    strips[ch].process(buffer.getWritePointer(ch, start), passSamples);
+
+            if (numStrips > 1)
+                blendDualMono(buffer, start, passSamples, runRightStrip);
+        }
+
+        DRIVE_TRACE_SCOPE("coupled stages", "audio");
+        for (int offset = 0; offset < passSamples; offset += internalBlockSize)
+            processCoupledChunk(buffer, start, offset, juce::jmin(internalBlockSize, passSamples - offset), coupled);
+    }
+
+    // =========================================================================
+    // OUTPUT CHECK
+    // Input is clean at this point, so a NaN/Inf here means some internal
+    // state blew up. Reset it rather than staying silent until reload
+    // =========================================================================
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        if (SignalSanitizer::hasNonFinite(buffer.getReadPointer(ch), numSamples))
+        {
+            resetDspState();
+            buffer.clear();
+            stateResets.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+}
+
+void DriveEngine::publishMeters()
+{
+    // Visualizer: RMS captures low frequency energy better than peak
+    const float rms = inputMeter.getBlockRms();
+    const float peak = inputMeter.getBlockPeak();
+    inputRMS.store(rms);
+    inputPeak.store(peak);
+    inputTruePeak.store(inputMeter.getBlockTruePeak());
+
+    outputRMS.store(outputMeter.getBlockRms());
+    outputPeak.store(outputMeter.getBlockPeak());
+    outputTruePeak.store(outputMeter.getBlockTruePeak());
+
+    // Envelope follower uses combination of RMS and peak for better low-end response
+    // RMS * 2 to boost its contribution (low frequencies have more RMS than peak)
+    const float combinedLevel = std::max(peak, rms * 2.5f);
+    float env = envelopeFollower.load();
+    env = std::max(env * envelopeCoeff, combinedLevel);
+    envelopeFollower.store(env);
+}
+
+void DriveEngine::clearMeters()
+{
+    inputRMS.store(0.0f);
+    inputPeak.store(0.0f);
+    inputTruePeak.store(0.0f);
+    outputRMS.store(0.0f);
+    outputPeak.store(0.0f);
+    outputTruePeak.store(0.0f);
+    envelopeFollower.store(0.0f);
+}
+
+void DriveEngine::resetDspState()
+{
+    for (auto& strip : strips)
+        strip.reset();
+
+    ceilingStage.reset();
+    outputGain.reset();
+    mixDelay.reset();
+    inputLoudness.reset();
+    outputLoudness.reset();
+    inputMeter.reset();
+    outputMeter.reset();
+    autoGainSmoothed.setCurrentAndTargetValue(1.0f);
+
+    identicalSamples = 0;
+    dualMonoWanted = false;
+    dualMonoMix = 0.0f;
+}
+
+bool DriveEngine::updateDualMono(const juce::AudioBuffer<float>& buffer, int numStrips, int numSamples)
+{
+    if (numStrips < 2)
+        return false;
+
+    // Exits at the first differing sample, so true stereo costs next to nothing
+    const float* left = buffer.getReadPointer(0);
+    const float* right = buffer.getReadPointer(1);
+    const bool identical = std::equal(left, left + numSamples, right);
+
+    if (!identical)
+    {
+        identicalSamples = 0;
+
+        if (dualMonoWanted)
+        {
+            // Strip 1 has been idle: it resumes from strip 0's state, which is
+            // where it would be had it processed the same input
+            if (dualMonoMix >= 1.0f)
+                strips[1].copyStateFrom(strips[0]);
+
+            dualMonoWanted = false;
+        }
+    }
+    else if (!dualMonoWanted)
+    {
+        identicalSamples += numSamples;
+        dualMonoWanted = identicalSamples >= dualMonoHoldSamples;
+    }
+
+    // Strip 1 only idles once the copy has fully faded in
+    return !(dualMonoWanted && dualMonoMix >= 1.0f);
+}
+
+void DriveEngine::blendDualMono(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, bool rightStripRan)
+{
+    const float* left = buffer.getReadPointer(0, startSample);
+    float* right = buffer.getWritePointer(1, startSample);
+
+    if (!rightStripRan)
+    {
+        juce::FloatVectorOperations::copy(right, left, numSamples);
+        return;
+    }
+
+    if (!dualMonoWanted && dualMonoMix <= 0.0f)
+        return;
+
+    // Crossfade covers the fresh oversampler state after a resume, and any
+    // leftover state difference on the way in
+    const float target = dualMonoWanted ? 1.0f : 0.0f;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        dualMonoMix = target > dualMonoMix ? juce::jmin(target, dualMonoMix + dualMonoStep)
+                                           : juce::jmax(target, dualMonoMix - dualMonoStep);
+        right[i] += (left[i] - right[i]) * dualMonoMix;
+    }
+}
+
+void DriveEngine::resetSanitizerCounters()
+{
+    sanitizedNonFinite.store(0);
+    sanitizedDenormals.store(0);
+    stateResets.store(0);
+}
+
+size_t DriveEngine::getBufferBytes() const
+{
+    const auto floatBytes = [](size_t numFloats) { return numFloats * sizeof(float); };
+    const auto channels = static_cast<size_t>(setup.numChannels);
+    const auto chunk = static_cast<size_t>(setup.internalBlockSize);
+
+    // Dry copy (one pass), mix and bypass delays, channel strips, ceiling oversampler
+    size_t bytes = floatBytes(channels * static_cast<size_t>(passSize + setup.internalBlockSize))
+                   + mixDelay.getBufferBytes() + softBypass.getBufferBytes();
+
+    for (const auto& strip : strips)
+        bytes += strip.getBufferBytes();
+
+    for (size_t stage = 1; stage <= static_cast<size_t>(kOversamplingStages); ++stage)
+        bytes += floatBytes(channels * chunk * (size_t(1) << stage));
+
+    return bytes;
+}
+
+void DriveEngine::processStripsInParallel(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    auto& pool = offlinePool->getPool();
+
+    stripJob->strip = &strips[1];
+    stripJob->data = buffer.getWritePointer(1, startSample);
+    stripJob->numSamples = numSamples;
+    pool.addJob(stripJob.get(), false);
+
+    strips[0].process(buffer.getWritePointer(0, startSample), numSamples);
+
+    pool.waitForJobToFinish(stripJob.get(), -1);
+}
+
+void DriveEngine::processCoupledChunk(juce::AudioBuffer<float>& buffer, int passStart, int offset, int numSamples,
+                                      const CoupledParameters& coupled)
+{
+    const int startSample = passStart + offset;
+    const int numChannels = juce::jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+    auto block = juce::dsp::AudioBlock<float>(buffer)
+                     .getSubsetChannelBlock(0, static_cast<size_t>(numChannels))
+                     .getSubBlock(static_cast<size_t>(startSample), static_cast<size_t>(numSamples));
+
+    const float mixNorm = coupled.mixNorm;
+
+    {
+        // The dry copy is the input: one pass for the visualizer and auto gain
+        DRIVE_TRACE_SCOPE("input meter", "audio");
+        const float* dry[2] = { dryBuffer.getReadPointer(0, offset),
+                                numChannels > 1 ? dryBuffer.getReadPointer(1, offset) : nullptr };
+        inputMeter.process(dry, numChannels, numSamples, coupled.autoGain ? &inputLoudness : nullptr);
+    }
+
+    // =========================================================================
+    // STAGE 5: STEREO WIDTH
+    // =========================================================================
+    if (coupled.doWidth)
+    {
+        const float widthNorm = coupled.widthNorm;
+        auto* left = buffer.getWritePointer(0, startSample);
+        auto* right = buffer.getWritePointer(1, startSample);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float mid = (left[i] + right[i]) * 0.5f;
+            const float side = (left[i] - right[i]) * 0.5f * widthNorm;
+            left[i] = mid + side;
+            right[i] = mid - side;
+        }
+    }
+
+    // =========================================================================
+    // STAGE 6: DRY/WET MIX
+    // =========================================================================
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* dry = dryBuffer.getReadPointer(ch, offset);
+
+        // Fully wet: the delay only has to stay current
+        if (mixNorm >= 1.0f)
+        {
+            mixDelay.write(ch, dry, numSamples);
+            continue;
+        }
+
+        auto* wet = buffer.getWritePointer(ch, startSample);
+        auto* delayedDry = delayedDryBuffer.getWritePointer(ch);
+        mixDelay.process(ch, dry, delayedDry, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            wet[i] = wet[i] * mixNorm + delayedDry[i] * (1.0f - mixNorm);
+        }
+    }
+
+    // =========================================================================
+    // STAGE 7: AUTO GAIN (Very smooth loudness matching)
+    // Input and output loudness are tracked at a fixed control rate with time
+    // constants in seconds, so the behaviour is the same at any buffer size.
+    // Slow averaging avoids pumping - it just maintains overall level
+    // =========================================================================
+    {
+        DRIVE_TRACE_SCOPE("output meter", "audio");
+        const float* outputs[2] = { buffer.getReadPointer(0, startSample),
+                                    numChannels > 1 ? buffer.getReadPointer(1, startSample) : nullptr };
+        outputMeter.process(outputs, numChannels, numSamples, coupled.autoGain ? &outputLoudness : nullptr);
+    }
+
+    if (coupled.autoGain)
+    {
+        const float inputMs = inputLoudness.getMeanSquare();
+        const float outputMs = outputLoudness.getMeanSquare();
+
+        // Only update when we have meaningful signal (-60 dB RMS)
+        if (inputMs > 1.0e-6f && outputMs > 1.0e-6f)
+        {
+            const float targetGain = std::sqrt(inputMs / outputMs);
+            // Tighter clamp range for subtler compensation
+            autoGainSmoothed.setTargetValue(std::clamp(targetGain, 0.5f, 2.0f));
+        }
+
+        // Always apply the smoothed gain (even during silence)
+        float* channels[2] = { buffer.getWritePointer(0, startSample),
+                               numChannels > 1 ? buffer.getWritePointer(1, startSample) : nullptr };
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float gain = autoGainSmoothed.getNextValue();
+            for (int ch = 0; ch < numChannels; ++ch)
+                channels[ch][i] *= gain;
+        }
+    }
+
+    // Output gain
+    juce::dsp::ProcessContextReplacing<float> gainContext(block);
+    outputGain.process(gainContext);
+
+    // =========================================================================
+    // STAGE 8: TRUE-PEAK CEILING
+    // Oversampled clip/limit so inter-sample overs never leave the plugin
+    // =========================================================================
+    ceilingStage.process(block, coupled.ceilingMode, coupled.ceilingGain);
+
+    // Bypass dry path: always fed, mixed in while bypassing or fading back
+    const float* dry[2] = { dryBuffer.getReadPointer(0, offset),
+                            numChannels > 1 ? dryBuffer.getReadPointer(1, offset) : nullptr };
+    float* processed[2] = { buffer.getWritePointer(0, startSample),
+                            numChannels > 1 ? buffer.getWritePointer(1, startSample) : nullptr };
+    softBypass.process(dry, processed, numChannels, numSamples);
+}
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "ParameterIDs.h"
+#include "StateSerializer.h"
+#include "TruePeakLimiter.h"
+#include "LoudnessTracker.h"
+#include "LevelMeter.h"
+#include "ChannelStrip.h"
+#include "AdaaTables.h"
+#include "OfflineRenderPool.h"
+#include "QualityGovernor.h"
+#include "SoftBypass.h"
+#include "LatencyDelay.h"
+#include "TraceRecorder.h"
+
+#include <atomic>
+#include <memory>
+
+/**
+ * The complete DRIVE signal chain, with no dependency on the plugin wrapper,
+ * the editor, the WebView or the activation SDK.
+ *
+ * Processes planar float channels in place (the caller's buffers are used
+ * directly, nothing is copied in or out) with plain parameter values, so the
+ * same DSP runs inside DriveAudioProcessor, in the tools, and headless
+ * through the C API (DriveDSP.h).
+ *
+ * Threading: prepare(), setParameters(), transitionToParameters(), process(),
+ * reset() and setState()
+ * must not run concurrently, i.e. call them from the processing thread or
+ * between blocks. The meter and counter getters can be called from any
+ * thread.
+ */
+class DriveEngine
+{
+public:
+    // Internal processing chunk size. Takes effect on the next prepare()
+    static constexpr int kDefaultInternalBlockSize = 64;
+    static constexpr int kMinInternalBlockSize = 16;
+    static constexpr int kMaxInternalBlockSize = 2048;
+    static constexpr int kMaxChannels = 2;
+
+    /** Parameter values in their natural units, one per ParameterIDs::stateOrder entry. */
+    struct Parameters
+    {
+        float drive = ParameterIDs::Ranges::driveDefault;              // %
+        float pressure = ParameterIDs::Ranges::pressureDefault;        // %
+        float tone = ParameterIDs::Ranges::toneDefault;                // -100 to +100
+        float mix = ParameterIDs::Ranges::mixDefault;                  // %
+        float output = ParameterIDs::Ranges::outputDefault;            // dB
+        int mode = ParameterIDs::Ranges::modeDefault;                  // 0=Tube, 1=Tape, 2=Transistor
+        float attack = ParameterIDs::Ranges::attackDefault;            // -100 to +100
+        float sustain = ParameterIDs::Ranges::sustainDefault;          // -100 to +100
+        float sidechainHp = ParameterIDs::Ranges::sidechainHpDefault;  // Hz
+        bool autoGain = false;
+        float stereoWidth = ParameterIDs::Ranges::stereoWidthDefault;  // %
+        bool bypass = false;
+        int ceilingMode = ParameterIDs::Ranges::ceilingModeDefault;    // 0=Off, 1=Clip, 2=Limit
+        float ceiling = ParameterIDs::Ranges::ceilingDefault;          // dBTP
+        int oversampling = ParameterIDs::Ranges::oversamplingDefault;  // 0=1x, 1=2x, 2=4x
+        bool adaa = false;
+        bool adaptiveQuality = false;
+
+        /** Conversion to and from the state format's value array. */
+        static Parameters fromStateValues(const StateSerializer::Values& values);
+        StateSerializer::Values toStateValues() const;
+    };
+
+    struct ProcessSetup
+    {
+        double sampleRate = 44100.0;
+        int numChannels = 2;
+        int internalBlockSize = kDefaultInternalBlockSize;
+        bool nonRealtime = false;  // offline passes run the channels on separate threads
+    };
+
+    DriveEngine();
+    ~DriveEngine();
+
+    /** Allocates everything process() needs. Any block length is accepted afterwards. */
+    void prepare(const ProcessSetup& newSetup);
+    const ProcessSetup& getSetup() const { return setup; }
+
+    /** Offline passes need the longer buffers from a prepare() with nonRealtime set; going realtime is immediate. */
+    void setNonRealtime(bool isNonRealtime) { setup.nonRealtime = isNonRealtime; }
+
+    /** Clears filter, envelope, loudness and bypass delay state (after a glitch or a transport jump). */
+    void reset();
+
+    /** Takes effect from the next process() call. */
+    void setParameters(const Parameters& newParameters);
+
+    /**
+     * Switches to a whole new parameter set (preset or state load) without a
+     * click or a gap: the continuous parameters glide from their current
+     * values to the new ones over kTransitionSeconds, one internal chunk at
+     * a time, while the choices and switches change at once (the mode,
+     * oversampling and bypass have their own crossfades). setParameters()
+     * calls during the glide update the target. Immediate if nothing has
+     * been processed since prepare() or reset().
+     */
+    void transitionToParameters(const Parameters& newParameters);
+
+    /** The parameters in effect, or the ones a transition is heading to. */
+    const Parameters& getParameters() const { return transitionRemaining > 0 ? transitionTarget : params; }
+
+    /** Processes planar channels in place. numChannels beyond kMaxChannels are left untouched. */
+    void process(float* const* channels, int numChannels, int numSamples);
+
+    /**
+     * Total delay in samples at the prepared rate. Fixed from prepare() on:
+     * no parameter changes it (the faster oversampling paths and the ceiling
+     * modes are padded to the slowest), so it is never reported again while
+     * audio runs.
+     */
+    int getLatencyInSamples() const;
+
+    /** The parameters in the plugin's binary state format (StateSerializer). */
+    void getState(juce::MemoryBlock& destData) const;
+
+    /** Restores a binary state blob. Returns false (and changes nothing) if it isn't one. */
+    bool setState(const void* data, int sizeInBytes);
+
+    // Meters: levels of the last processed block, input (pre-drive) and after
+    // the dry/wet mix (the auto-gain reference point)
+    float getInputRMS() const { return inputRMS.load(); }
+    float getInputPeak() const { return inputPeak.load(); }
+    float getInputTruePeak() const { return inputTruePeak.load(); }
+    float getOutputRMS() const { return outputRMS.load(); }
+    float getOutputPeak() const { return outputPeak.load(); }
+    float getOutputTruePeak() const { return outputTruePeak.load(); }
+    float getEnvelopeFollower() const { return envelopeFollower.load(); }
+
+    /** Saturation quality the last block ran with (lower than requested under adaptive quality). */
+    struct ActiveQuality
+    {
+        int oversamplingStages = 0;
+        bool adaa = false;
+        bool reduced = false;  // below the requested oversampling
+    };
+
+    ActiveQuality getActiveQuality() const
+    {
+        return { activeOversamplingStages.load(std::memory_order_relaxed), activeAdaa.load(std::memory_order_relaxed),
+                 qualityReduced.load(std::memory_order_relaxed) };
+    }
+
+    /** True-peak metering is only worth its cost while a UI shows it. */
+    void setTruePeakMetering(bool shouldMeasure) { truePeakMetering.store(shouldMeasure); }
+
+    // Sanitizer counters (since creation or the last reset)
+    juce::uint32 getSanitizedNonFinite() const { return sanitizedNonFinite.load(std::memory_order_relaxed); }
+    juce::uint32 getSanitizedDenormals() const { return sanitizedDenormals.load(std::memory_order_relaxed); }
+    juce::uint32 getStateResets() const { return stateResets.load(std::memory_order_relaxed); }
+    void resetSanitizerCounters();
+
+    /** Bytes of per-instance buffers (for the processor's memory report). */
+    size_t getBufferBytes() const;
+
+    /** ADAA falls back to plain saturation until these are built. */
+    const AdaaTables* getAdaaTables() const { return adaaTables->get(); }
+
+private:
+    // Per-block values for the stereo-coupled stages (5-8)
+    struct CoupledParameters
+    {
+        float mixNorm = 1.0f;
+        float widthNorm = 1.0f;
+        bool doWidth = false;
+        bool autoGain = false;
+        TruePeakLimiter::Mode ceilingMode = TruePeakLimiter::Mode::off;
+        float ceilingGain = 1.0f;
+    };
+
+    /** One host block, or one chunk of it while a transition glides. */
+    void processBlock(float* const* channels, int numChannels, int numSamples);
+    void resetDspState();
+    void publishMeters();
+    void clearMeters();
+    void finishTransition();
+    void advanceTransition(int numSamples);
+    bool updateDualMono(const juce::AudioBuffer<float>& buffer, int numStrips, int numSamples);
+    void blendDualMono(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, bool rightStripRan);
+
+    class StripJob;
+    void processStripsInParallel(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+    void processCoupledChunk(juce::AudioBuffer<float>& buffer, int passStart, int offset, int numSamples,
+                             const CoupledParameters& coupled);
+
+    ProcessSetup setup;
+    Parameters params;
+    bool hasProcessed = false;  // since prepare() or reset()
+
+    // Parameter set transition: params glides from transitionStart to
+    // transitionTarget over transitionLength samples
+    static constexpr double kTransitionSeconds = 0.03;
+    Parameters transitionStart;
+    Parameters transitionTarget;
+    int transitionLength = 1;
+    int transitionRemaining = 0;  // 0 = no transition
+
+    // Shared by all engines in the process
+    juce::SharedResourcePointer<SharedAdaaTables> adaaTables;
+    juce::SharedResourcePointer<TraceRecorder> traceRecorder;  // idle unless DRIVE_TRACE is set
+
+    // Internal chunking. Realtime passes are one chunk; offline passes are
+    // kOfflinePassSize so the per-channel work is worth handing to a thread
+    static constexpr int kOfflinePassSize = 4096;
+    int passSize = kDefaultInternalBlockSize;
+    juce::AudioBuffer<float> dryBuffer;  // one pass
+
+    // Dry signal for the dry/wet mix, delayed by the strips' latency so a
+    // partial mix doesn't comb-filter (the ceiling runs after the mix)
+    LatencyDelay mixDelay;
+    juce::AudioBuffer<float> delayedDryBuffer;  // one internal chunk
+
+    // Per-channel stages 1-4 (independent state, safe to run concurrently)
+    ChannelStrip strips[kMaxChannels];
+
+    // Dual-mono fast path: after kDualMonoHoldSeconds of bit-identical
+    // input channels only strip 0 runs and channel 1 gets its output. The
+    // right channel crossfades between its own strip and the copy (mix 0-1)
+    // on the way in and out
+    static constexpr double kDualMonoHoldSeconds = 0.1;
+    static constexpr double kDualMonoFadeSeconds = 0.01;
+    int dualMonoHoldSamples = 1;
+    int identicalSamples = 0;
+    bool dualMonoWanted = false;
+    float dualMonoMix = 0.0f;
+    float dualMonoStep = 1.0f;  // per sample
+
+    // Bypass: fades to the input delayed by the latency. Once fully
+    // bypassed only its delay line runs, and the meters read silence
+    SoftBypass softBypass;
+    bool bypassIdle = false;
+
+    // Offline-only workers, shared by all engines
+    juce::SharedResourcePointer<OfflineRenderPool> offlinePool;
+    std::unique_ptr<StripJob> stripJob;
+
+    static constexpr int kOversamplingStages = ChannelStrip::kOversamplingStages;
+    juce::dsp::Gain<float> outputGain;
+
+    // Adaptive quality (oversampling/ADAA tier) and what the last block used
+    QualityGovernor governor;
+    std::atomic<int> activeOversamplingStages { ParameterIDs::Ranges::oversamplingDefault };
+    std::atomic<bool> activeAdaa { false };
+    std::atomic<bool> qualityReduced { false };
+
+    // True-peak output ceiling (same oversampling design as the drive stage,
+    // always at its highest factor)
+    TruePeakLimiter ceilingStage { kOversamplingStages };
+
+    // Auto gain: loudness tracked at control rate, gain ramped per sample
+    // (~500ms to fully adjust, so it won't react to individual hits)
+    static constexpr float kLoudnessTimeConstant = 0.4f;
+    static constexpr double kAutoGainRampSeconds = 0.5;
+    LoudnessTracker inputLoudness;
+    LoudnessTracker outputLoudness;
+    bool autoGainWasOn = false;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> autoGainSmoothed { 1.0f };
+
+    // Fused meters: input (visualizer, input loudness) and post-mix (UI,
+    // output loudness)
+    LevelMeter inputMeter;
+    LevelMeter outputMeter;
+    std::atomic<bool> truePeakMetering { false };
+    float envelopeCoeff = 0.0f;
+
+    // Published levels (atomic for thread safety)
+    std::atomic<float> inputRMS { 0.0f };
+    std::atomic<float> inputPeak { 0.0f };
+    std::atomic<float> inputTruePeak { 0.0f };
+    std::atomic<float> outputRMS { 0.0f };
+    std::atomic<float> outputPeak { 0.0f };
+    std::atomic<float> outputTruePeak { 0.0f };
+    std::atomic<float> envelopeFollower { 0.0f };
+
+    // Sanitizer counters: NaN/Inf and denormal input samples replaced, and
+    // internal state resets after a non-finite output
+    std::atomic<juce::uint32> sanitizedNonFinite { 0 };
+    std::atomic<juce::uint32> sanitizedDenormals { 0 };
+    std::atomic<juce::uint32> stateResets { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DriveEngine)
+};
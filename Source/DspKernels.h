@@ -0,0 +1,379 @@
+#pragma once
+
+#include "SaturationKernels.h"
+
+/**
+ * Inner loops of the channel strip, specialised at compile time.
+ *
+ * Every per-sample decision that is constant for a block (saturation mode,
+ * which transient controls are active) is a template parameter, so each
+ * instantiation is a straight-line loop with no dead branches. ChannelStrip
+ * picks the instantiation once per block from a KernelTable; KernelDispatch
+ * decides which ISA level's table that is.
+ */
+namespace DspKernels
+{
+    /** Envelope state of the transient detector (persists across blocks). */
+    struct TransientState
+    {
+        float fastEnvelope = 0.0f;
+        float slowEnvelope = 0.0f;
+    };
+
+    /**
+     * Tabulated antiderivative of one saturation curve (see AdaaTables).
+     * points holds F(x) and f(x) interleaved on a uniform grid.
+     */
+    struct AdaaCurve
+    {
+        const double* points = nullptr;
+        int numPoints = 0;
+        double xMin = 0.0;
+        double xMax = 0.0;
+        double step = 1.0;
+        double invStep = 1.0;
+    };
+
+    /** ADAA needs the previous (driven) input sample. */
+    struct AdaaState
+    {
+        double xPrev = 0.0;
+    };
+
+    /** Levels accumulated by the metering kernel. */
+    struct MeterResult
+    {
+        double sumSquares = 0.0;
+        float peak = 0.0f;
+        float truePeak = 0.0f;  // 4x oversampled, only with the true-peak variant
+    };
+
+    // 4x polyphase true-peak interpolator: kTruePeakTaps input samples per phase
+    inline constexpr int kTruePeakPhases = 4;
+    inline constexpr int kTruePeakTaps = 12;
+
+    using TransientKernel = void (*)(float*, int, TransientState&, float, float);
+    using SaturationKernel = void (*)(float*, const float*, int, float, float);
+    using AdaaKernel = void (*)(float*, const float*, int, float, float,
+                                const AdaaCurve&, const AdaaCurve&, double, AdaaState&);
+    using MeterKernel = void (*)(const float*, int, const float*, int, int, float*, MeterResult&);
+
+    /** One ISA level's instantiations of every kernel. */
+    struct KernelTable
+    {
+        TransientKernel transient[2][2];   // [shapeAttack][shapeSustain]
+        SaturationKernel saturation[SaturationKernels::numModes];
+        AdaaKernel adaa;
+        MeterKernel meter[2];              // [truePeak]
+    };
+
+#if DRIVE_ISA_DISPATCH
+    // Defined in DspKernelsSSE41.cpp, DspKernelsAVX2.cpp, DspKernelsAVX512.cpp
+    const KernelTable& getSse41Kernels();
+    const KernelTable& getAvx2Kernels();
+    const KernelTable& getAvx512Kernels();
+#endif
+
+inline namespace DRIVE_KERNEL_ISA
+{
+
+    // =========================================================================
+    // STAGE 1: TRANSIENT SHAPING (Attack & Sustain)
+    // Clean implementation: separate transient and sustain processing
+    // =========================================================================
+    template <bool ShapeAttack, bool ShapeSustain>
+    void shapeTransients(float* data, int numSamples, TransientState& state, float attackNorm, float sustainNorm)
+    {
+        float fastEnvelope = state.fastEnvelope;
+        float slowEnvelope = state.slowEnvelope;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float input = data[i];
+            const float absVal = SaturationKernels::absValue(input);
+
+            // ENVELOPE DETECTION
+            // Fast envelope: instant attack, ~10ms release (catches transients)
+            if (absVal > fastEnvelope)
+                fastEnvelope = absVal;
+            else
+                fastEnvelope += (absVal - fastEnvelope) * 0.002f; // ~10ms at 44.1k
+
+            // Slow envelope: ~5ms attack, ~100ms release (follows body)
+            if (absVal > slowEnvelope)
+                slowEnvelope += (absVal - slowEnvelope) * 0.01f; // ~5ms attack
+            else
+                slowEnvelope += (absVal - slowEnvelope) * 0.0004f; // ~100ms release
+
+            // TRANSIENT DETECTION
+            // Transient = when fast envelope significantly exceeds slow
+            const float envDiff = fastEnvelope - slowEnvelope;
+            const float transient = SaturationKernels::maxValue(0.0f, envDiff) / (slowEnvelope + 0.001f);
+            const float transientSmooth = SaturationKernels::clampValue(transient, 0.0f, 1.0f);
+
+            // GAIN CALCULATION
+            float gain = 1.0f;
+
+            // ATTACK control: affects the transient portion
+            if constexpr (ShapeAttack)
+            {
+                // Positive = boost transients, Negative = soften transients
+                const float attackGain = 1.0f + attackNorm * transientSmooth * 4.0f;
+                gain *= SaturationKernels::clampValue(attackGain, 0.2f, 5.0f);
+            }
+
+            // SUSTAIN control: affects the body/tail (non-transient portion)
+            if constexpr (ShapeSustain)
+            {
+                // Only apply sustain shaping when NOT in a transient
+                const float sustainRegion = 1.0f - transientSmooth;
+                // Positive = boost sustain, Negative = gate/tighten
+                const float sustainGain = 1.0f + sustainNorm * sustainRegion * 2.0f;
+                gain *= SaturationKernels::clampValue(sustainGain, 0.3f, 3.0f);
+            }
+
+            data[i] = input * gain;
+        }
+
+        state.fastEnvelope = fastEnvelope;
+        state.slowEnvelope = slowEnvelope;
+    }
+
+    // =========================================================================
+    // STAGE 2: SATURATION (oversampled rate)
+    // Dynamic drive: base gain + envelope-following boost, then the mode curve
+    // =========================================================================
+    template <int Mode>
+    float shape(float x, float driveNorm)
+    {
+        if constexpr (Mode == SaturationKernels::tube)
+            return SaturationKernels::tubeSample(x, driveNorm);
+        else if constexpr (Mode == SaturationKernels::tape)
+            return SaturationKernels::tapeSample(x, driveNorm);
+        else
+            return SaturationKernels::transistorSample(x, driveNorm);
+    }
+
+    template <int Mode>
+    void saturate(float* data, const float* envelope, int numSamples, float baseDriveGain, float driveNorm)
+    {
+        const float envDepth = driveNorm * 10.0f;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Envelope-following drive: more saturation on loud parts
+            const float totalDrive = baseDriveGain * (1.0f + envelope[i] * envDepth);
+            data[i] = SaturationKernels::clampValue(shape<Mode>(data[i] * totalDrive, driveNorm), -1.5f, 1.5f);
+        }
+    }
+
+    // =========================================================================
+    // STAGE 2 (ADAA): first-order antiderivative anti-aliasing
+    // y[n] = (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1]), which suppresses the
+    // aliasing of the curve enough to run at 1x/2x instead of 4x. Adds half
+    // a sample of delay at the processing rate
+    // =========================================================================
+    inline double evalAntiderivative(const AdaaCurve& curve, double x)
+    {
+        const double* p = curve.points;
+
+        // Curves are flat outside the table, so F continues linearly
+        if (x <= curve.xMin)
+            return p[0] + p[1] * (x - curve.xMin);
+
+        if (x >= curve.xMax)
+        {
+            const double* last = p + 2 * (curve.numPoints - 1);
+            return last[0] + last[1] * (x - curve.xMax);
+        }
+
+        const double t = (x - curve.xMin) * curve.invStep;
+        int i = static_cast<int>(t);
+        if (i > curve.numPoints - 2)
+            i = curve.numPoints - 2;
+
+        // Cubic Hermite from F and F' = f at both ends of the interval
+        const double u = t - static_cast<double>(i);
+        const double u2 = u * u;
+        const double u3 = u2 * u;
+        const double* a = p + 2 * i;
+
+        return (2.0 * u3 - 3.0 * u2 + 1.0) * a[0]
+             + (u3 - 2.0 * u2 + u) * a[1] * curve.step
+             + (3.0 * u2 - 2.0 * u3) * a[2]
+             + (u3 - u2) * a[3] * curve.step;
+    }
+
+    inline double evalCurve(const AdaaCurve& curve, double x)
+    {
+        const double* p = curve.points;
+
+        if (x <= curve.xMin)
+            return p[1];
+        if (x >= curve.xMax)
+            return p[2 * (curve.numPoints - 1) + 1];
+
+        const double t = (x - curve.xMin) * curve.invStep;
+        int i = static_cast<int>(t);
+        if (i > curve.numPoints - 2)
+            i = curve.numPoints - 2;
+
+        const double u = t - static_cast<double>(i);
+        const double* a = p + 2 * i;
+        return a[1] + (a[3] - a[1]) * u;
+    }
+
+    /** One ADAA output sample without cached state (used while crossfading modes). */
+    inline double adaaSample(const AdaaCurve& lower, const AdaaCurve& upper, double blend, double x, double xPrev)
+    {
+        constexpr double kMinDelta = 1.0e-5;
+        const double dx = x - xPrev;
+
+        if (dx > kMinDelta || dx < -kMinDelta)
+        {
+            const double fx = evalAntiderivative(lower, x) + blend * (evalAntiderivative(upper, x) - evalAntiderivative(lower, x));
+            const double fp = evalAntiderivative(lower, xPrev) + blend * (evalAntiderivative(upper, xPrev) - evalAntiderivative(lower, xPrev));
+            return (fx - fp) / dx;
+        }
+
+        // Ill-conditioned: fall back to the curve at the midpoint
+        const double mid = 0.5 * (x + xPrev);
+        return evalCurve(lower, mid) + blend * (evalCurve(upper, mid) - evalCurve(lower, mid));
+    }
+
+    inline void saturateAdaa(float* data, const float* envelope, int numSamples, float baseDriveGain, float driveNorm,
+                             const AdaaCurve& lower, const AdaaCurve& upper, double blend, AdaaState& state)
+    {
+        constexpr double kMinDelta = 1.0e-5;
+        const float envDepth = driveNorm * 10.0f;
+        const double lowerWeight = 1.0 - blend;
+
+        double xPrev = state.xPrev;
+        double fPrev = lowerWeight * evalAntiderivative(lower, xPrev) + blend * evalAntiderivative(upper, xPrev);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Envelope-following drive: more saturation on loud parts
+            const float totalDrive = baseDriveGain * (1.0f + envelope[i] * envDepth);
+            const double x = static_cast<double>(data[i] * totalDrive);
+            const double fx = lowerWeight * evalAntiderivative(lower, x) + blend * evalAntiderivative(upper, x);
+            const double dx = x - xPrev;
+
+            double y;
+            if (dx > kMinDelta || dx < -kMinDelta)
+            {
+                y = (fx - fPrev) / dx;
+            }
+            else
+            {
+                const double mid = 0.5 * (x + xPrev);
+                y = lowerWeight * evalCurve(lower, mid) + blend * evalCurve(upper, mid);
+            }
+
+            data[i] = static_cast<float>(y);
+            xPrev = x;
+            fPrev = fx;
+        }
+
+        state.xPrev = xPrev;
+    }
+
+    // =========================================================================
+    // METERING: sum of squares, peak and (optionally) 4x true peak of one
+    // channel in a single pass. Squares are also summed per frame of
+    // frameLength samples (starting framePhase samples into the first frame)
+    // into frameSums, for the loudness trackers. With TruePeak, data must be
+    // preceded by kTruePeakTaps - 1 samples of history
+    // =========================================================================
+    template <bool TruePeak>
+    void meter(const float* data, int numSamples, const float* coeffs, int framePhase, int frameLength,
+               float* frameSums, MeterResult& result)
+    {
+        constexpr int kLanes = 8;
+        float peak = result.peak;
+        float truePeak = result.truePeak;
+        double total = 0.0;
+        int phase = framePhase;
+        int frame = 0;
+
+        for (int pos = 0; pos < numSamples;)
+        {
+            const int todo = numSamples - pos < frameLength - phase ? numSamples - pos : frameLength - phase;
+            const float* x = data + pos;
+
+            // Independent lanes, so the loop maps onto one vector register
+            float sums[kLanes] = {};
+            float peaks[kLanes] = {};
+            int i = 0;
+
+            for (; i + kLanes <= todo; i += kLanes)
+            {
+                for (int l = 0; l < kLanes; ++l)
+                {
+                    const float v = x[i + l];
+                    sums[l] += v * v;
+                    peaks[l] = SaturationKernels::maxValue(peaks[l], SaturationKernels::absValue(v));
+                }
+            }
+
+            float sum = 0.0f;
+            for (; i < todo; ++i)
+            {
+                sum += x[i] * x[i];
+                peak = SaturationKernels::maxValue(peak, SaturationKernels::absValue(x[i]));
+            }
+
+            for (int l = 0; l < kLanes; ++l)
+            {
+                sum += sums[l];
+                peak = SaturationKernels::maxValue(peak, peaks[l]);
+            }
+
+            if constexpr (TruePeak)
+            {
+                // Same samples, still in L1
+                for (int j = 0; j < todo; ++j)
+                {
+                    for (int p = 0; p < kTruePeakPhases; ++p)
+                    {
+                        const float* h = coeffs + p * kTruePeakTaps;
+                        float acc = 0.0f;
+                        for (int k = 0; k < kTruePeakTaps; ++k)
+                            acc += h[k] * x[j - k];
+                        truePeak = SaturationKernels::maxValue(truePeak, SaturationKernels::absValue(acc));
+                    }
+                }
+            }
+
+            frameSums[frame] += sum;
+            total += static_cast<double>(sum);
+            phase += todo;
+            pos += todo;
+
+            if (phase == frameLength)
+            {
+                phase = 0;
+                ++frame;
+            }
+        }
+
+        result.sumSquares += total;
+        result.peak = peak;
+        result.truePeak = TruePeak ? SaturationKernels::maxValue(truePeak, peak) : truePeak;
+    }
+
+    /** This translation unit's ISA level instantiations. */
+    inline KernelTable makeKernelTable()
+    {
+        return {
+            { { &shapeTransients<false, false>, &shapeTransients<false, true> },
+              { &shapeTransients<true, false>,  &shapeTransients<true, true> } },
+            { &saturate<SaturationKernels::tube>,
+              &saturate<SaturationKernels::tape>,
+              &saturate<SaturationKernels::transistor> },
+            &saturateAdaa,
+            { &meter<false>, &meter<true> }
+        };
+    }
+} // namespace DRIVE_KERNEL_ISA
+}
@@ -0,0 +1,14 @@
+// DspKernels compiled with AVX2 + FMA code generation (flags set in CMakeLists.txt).
+// Only called after KernelDispatch has checked the CPU supports it.
+
+#define DRIVE_KERNEL_ISA avx2
+#include "DspKernels.h"
+
+namespace DspKernels
+{
+    const KernelTable& getAvx2Kernels()
+    {
+        static const KernelTable table = makeKernelTable();
+        return table;
+    }
+}
@@ -0,0 +1,14 @@
+// DspKernels compiled with AVX-512 (F/DQ/BW/VL) code generation (flags set in CMakeLists.txt).
+// Only called after KernelDispatch has checked the CPU supports it.
+
+#define DRIVE_KERNEL_ISA avx512
+#include "DspKernels.h"
+
+namespace DspKernels
+{
+    const KernelTable& getAvx512Kernels()
+    {
+        static const KernelTable table = makeKernelTable();
+        return table;
+    }
+}
@@ -0,0 +1,14 @@
+// DspKernels compiled with SSE4.1 code generation (flags set in CMakeLists.txt).
+// Only called after KernelDispatch has checked the CPU supports it.
+
+#define DRIVE_KERNEL_ISA sse41
+#include "DspKernels.h"
+
+namespace DspKernels
+{
+    const KernelTable& getSse41Kernels()
+    {
+        static const KernelTable table = makeKernelTable();
+        return table;
+    }
+}
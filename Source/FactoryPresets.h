@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ParameterIDs.h"
+
+/**
+ * Built-in factory presets. These are always part of the preset library,
+ * even when no preset folders exist on disk.
+ *
+ * Values are in the parameter's own range (same as the UI displays them).
+ * Parameters not listed keep their defaults.
+ */
+namespace FactoryPresets
+{
+    struct Preset
+    {
+        const char* name;
+        const char* tags;
+        float drive, pressure, tone, mix, output;
+        int mode;
+        float attack, sustain;
+        bool autoGain;
+    };
+
+    inline constexpr Preset presets[] = {
+        { "Init",              "init",                   0.0f,  0.0f,   0.0f, 100.0f,  0.0f, 0,   0.0f,   0.0f, false },
+        { "Clean Punch",       "drums punch clean",     20.0f, 30.0f,  10.0f,  80.0f,  0.0f, 0,  40.0f, -20.0f, true  },
+        { "Warm Tape",         "bus tape warm",         35.0f, 40.0f, -15.0f,  70.0f,  0.0f, 1,   0.0f,  20.0f, true  },
+        { "Tube Grit",         "drums tube grit",       55.0f, 25.0f,   5.0f,  85.0f, -2.0f, 0,  20.0f,   0.0f, true  },
+        { "Transistor Crunch", "drums transistor crunch", 60.0f, 35.0f, 20.0f, 75.0f, -3.0f, 2,  30.0f, -10.0f, true  },
+        { "Fat Kick",          "kick tube fat",         40.0f, 50.0f, -25.0f,  90.0f,  0.0f, 0, -30.0f,  40.0f, true  },
+        { "Snappy Snare",      "snare transistor snap", 30.0f, 20.0f,  15.0f,  85.0f,  0.0f, 2,  60.0f, -30.0f, true  },
+        { "Room Glue",         "room tape glue",        25.0f, 70.0f, -10.0f,  60.0f,  2.0f, 1, -20.0f,  50.0f, true  },
+        { "Vintage Warmth",    "bus tape vintage",      45.0f, 45.0f, -20.0f,  75.0f,  0.0f, 1,  10.0f,  30.0f, true  },
+        { "Modern Smack",      "drums transistor modern", 50.0f, 30.0f, 25.0f, 90.0f, -1.0f, 2,  70.0f, -40.0f, false },
+        { "Full Send",         "drums tube extreme",    85.0f, 60.0f,  10.0f, 100.0f, -4.0f, 0,  50.0f,  20.0f, true  },
+    };
+}
@@ -0,0 +1,92 @@
+#include "KernelDispatch.h"
+
+#include <juce_core/juce_core.h>
+
+namespace KernelDispatch
+{
+    namespace
+    {
+        Level getBestSupportedLevel()
+        {
+           #if DRIVE_ISA_DISPATCH
+            if (juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512DQ()
+                && juce::SystemStats::hasAVX512BW() && juce::SystemStats::hasAVX512VL())
+                return Level::avx512;
+
+            if (juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3())
+                return Level::avx2;
+
+            if (juce::SystemStats::hasSSE41())
+                return Level::sse41;
+           #endif
+
+            return Level::generic;
+        }
+
+        Level selectLevel()
+        {
+            auto level = getBestSupportedLevel();
+
+            const auto forced = juce::SystemStats::getEnvironmentVariable("DRIVE_KERNEL_ISA", {}).trim().toLowerCase();
+            if (forced.isNotEmpty())
+            {
+                for (auto candidate : { Level::generic, Level::sse41, Level::avx2, Level::avx512 })
+                {
+                    if (forced == getLevelName(candidate))
+                    {
+                        if (candidate > level)
+                            DBG("DRIVE_KERNEL_ISA=" + forced + " not supported by this CPU, using " + getLevelName(level));
+                        else
+                            level = candidate;
+                        break;
+                    }
+                }
+            }
+
+            DBG("Kernel ISA: " + juce::String(getLevelName(level)));
+            return level;
+        }
+
+        const DspKernels::KernelTable& getTableFor(Level level)
+        {
+            switch (level)
+            {
+               #if DRIVE_ISA_DISPATCH
+                case Level::avx512: return DspKernels::getAvx512Kernels();
+                case Level::avx2:   return DspKernels::getAvx2Kernels();
+                case Level::sse41:  return DspKernels::getSse41Kernels();
+               #endif
+                case Level::generic:
+                default:
+                {
+                    static const DspKernels::KernelTable table = DspKernels::makeKernelTable();
+                    return table;
+                }
+            }
+        }
+    }
+
+    Level getActiveLevel()
+    {
+        static const Level level = selectLevel();
+        return level;
+    }
+
+    const DspKernels::KernelTable& getKernels()
+    {
+        static const DspKernels::KernelTable& table = getTableFor(getActiveLevel());
+        return table;
+    }
+
+    const char* getLevelName(Level level)
+    {
+        switch (level)
+        {
+            case Level::sse41:   return "sse41";
+            case Level::avx2:    return "avx2";
+            case Level::avx512:  return "avx512";
+            case Level::generic:
+            default:             return "generic";
+        }
+    }
+}
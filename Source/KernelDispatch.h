@@ -0,0 +1,30 @@
+#pragma once
+
+#include "DspKernels.h"
+
+/**
+ * Picks which ISA level's kernels the channel strips use.
+ *
+ * On x86-64 builds the hot kernels are also compiled with SSE4.1, AVX2+FMA
+ * and AVX-512 code generation (one translation unit each). The best level the
+ * CPU supports is chosen on first use from JUCE's CPUID wrappers. Setting the
+ * environment variable DRIVE_KERNEL_ISA to generic, sse41, avx2 or avx512
+ * forces a level for testing (capped at what the CPU supports). Other builds
+ * (e.g. arm64) always use the generic kernels.
+ */
+namespace KernelDispatch
+{
+    enum class Level
+    {
+        generic = 0,
+        sse41,
+        avx2,
+        avx512
+    };
+
+    /** Kernel table for the active level (selected once per process). */
+    const DspKernels::KernelTable& getKernels();
+
+    Level getActiveLevel();
+    const char* getLevelName(Level level);
+}
@@ -0,0 +1,112 @@
+#include "LatencyDelay.h"
+
+#include <algorithm>
+#include <cmath>
+
+void LatencyDelay::prepare(int numChannels, int maxDelaySamples)
+{
+    // One extra sample: the sample is written before the read at the full delay
+    maxDelay = juce::jmax(0, maxDelaySamples);
+    const int size = juce::nextPowerOfTwo(maxDelay + 2);
+    mask = size - 1;
+
+    channels.resize(static_cast<size_t>(juce::jmax(1, numChannels)));
+    for (auto& channel : channels)
+        channel.ring.assign(static_cast<size_t>(size), 0.0f);
+
+    reset();
+}
+
+void LatencyDelay::reset()
+{
+    for (auto& channel : channels)
+    {
+        std::fill(channel.ring.begin(), channel.ring.end(), 0.0f);
+        channel.writePos = 0;
+        channel.allpassIn = 0.0f;
+        channel.allpassOut = 0.0f;
+    }
+}
+
+void LatencyDelay::setDelay(float delaySamples)
+{
+    delay = juce::jlimit(0.0f, static_cast<float>(maxDelay), delaySamples);
+
+    const float whole = std::floor(delay);
+    useAllpass = delay - whole > 1.0e-4f;
+
+    if (!useAllpass)
+    {
+        wholeSamples = static_cast<int>(whole);
+        return;
+    }
+
+    // Allpass share in [0.5, 1.5) where possible (below 0.5 it still works,
+    // with less even group delay)
+    wholeSamples = juce::jmax(0, static_cast<int>(std::floor(delay - 0.5f)));
+    const float fraction = delay - static_cast<float>(wholeSamples);
+    allpassCoeff = (1.0f - fraction) / (1.0f + fraction);
+}
+
+void LatencyDelay::process(int channel, const float* input, float* output, int numSamples)
+{
+    auto& c = channels[static_cast<size_t>(channel)];
+    auto* ring = c.ring.data();
+    int pos = c.writePos;
+
+    if (!useAllpass)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            ring[pos] = input[i];
+            output[i] = ring[(pos - wholeSamples) & mask];
+            pos = (pos + 1) & mask;
+        }
+    }
+    else
+    {
+        const float a = allpassCoeff;
+        float x1 = c.allpassIn;
+        float y1 = c.allpassOut;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            ring[pos] = input[i];
+            const float x = ring[(pos - wholeSamples) & mask];
+            const float y = a * (x - y1) + x1;
+            x1 = x;
+            y1 = y;
+            output[i] = y;
+            pos = (pos + 1) & mask;
+        }
+
+        c.allpassIn = x1;
+        c.allpassOut = y1;
+    }
+
+    c.writePos = pos;
+}
+
+void LatencyDelay::write(int channel, const float* input, int numSamples)
+{
+    // Two copies at most: up to the end of the ring, then from its start
+    auto& c = channels[static_cast<size_t>(channel)];
+    const int size = mask + 1;
+    int done = 0;
+
+    while (done < numSamples)
+    {
+        const int count = juce::jmin(numSamples - done, size - c.writePos);
+        juce::FloatVectorOperations::copy(c.ring.data() + c.writePos, input + done, count);
+        c.writePos = (c.writePos + count) & mask;
+        done += count;
+    }
+}
+
+size_t LatencyDelay::getBufferBytes() const
+{
+    size_t bytes = 0;
+    for (const auto& channel : channels)
+        bytes += channel.ring.size() * sizeof(float);
+    return bytes;
+}
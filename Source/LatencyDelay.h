@@ -0,0 +1,61 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <vector>
+
+/**
+ * Delay line that lines signals up with a latency, e.g. a dry path with the
+ * oversampled wet path.
+ *
+ * The whole-sample part is a power-of-two ring per channel. A fractional
+ * part (oversampling filters have non-integer latency) is a first-order
+ * Thiran allpass, which is flat in magnitude, so the delayed signal keeps
+ * its top end where linear interpolation would dull it. The allpass has its
+ * best group delay between 0.5 and 1.5 samples, so it takes that share of
+ * the delay.
+ *
+ * Channels keep their own position: call process() for every channel with
+ * the same numSamples each block.
+ */
+class LatencyDelay
+{
+public:
+    void prepare(int numChannels, int maxDelaySamples);
+    void reset();
+
+    /** 0 .. the prepared maximum. A change jumps; fade around it if it matters. */
+    void setDelay(float delaySamples);
+    float getDelay() const { return delay; }
+
+    /** Delays one channel. output may be the same as input. */
+    void process(int channel, const float* input, float* output, int numSamples);
+
+    /**
+     * Only records the input, for a delay whose output isn't needed right
+     * now but has to be current when it is. The allpass state isn't
+     * advanced, which costs a small transient when reading resumes.
+     */
+    void write(int channel, const float* input, int numSamples);
+
+    size_t getBufferBytes() const;
+
+private:
+    struct Channel
+    {
+        std::vector<float> ring;
+        int writePos = 0;
+        float allpassIn = 0.0f;   // x[n-1]
+        float allpassOut = 0.0f;  // y[n-1]
+    };
+
+    std::vector<Channel> channels;
+    int mask = 0;
+    int maxDelay = 0;
+    float delay = 0.0f;
+
+    // Current split of the delay
+    int wholeSamples = 0;
+    bool useAllpass = false;
+    float allpassCoeff = 0.0f;
+};
@@ -0,0 +1,159 @@
+#include "LevelMeter.h"
+#include "KernelDispatch.h"
+
+LevelMeter::LevelMeter()
+    : kernels(KernelDispatch::getKernels())
+{
+    // 4x interpolator: 48-tap Blackman-windowed sinc, split into four phases
+    // of kTruePeakTaps taps, each normalised to unity gain at DC
+    constexpr int phases = DspKernels::kTruePeakPhases;
+    constexpr int taps = DspKernels::kTruePeakTaps;
+    constexpr int length = phases * taps;
+    const double centre = (length - 1) * 0.5;
+
+    for (int p = 0; p < phases; ++p)
+    {
+        double sum = 0.0;
+        for (int k = 0; k < taps; ++k)
+        {
+            const int n = k * phases + p;
+            const double t = (n - centre) / phases;
+            const double sinc = std::abs(t) < 1.0e-9 ? 1.0 : std::sin(juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+            const double w = 0.42 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * (n + 0.5) / length)
+                           + 0.08 * std::cos(2.0 * juce::MathConstants<double>::twoPi * (n + 0.5) / length);
+            coeffs[p * taps + k] = static_cast<float>(sinc * w);
+            sum += sinc * w;
+        }
+
+        for (int k = 0; k < taps; ++k)
+            coeffs[p * taps + k] = static_cast<float>(coeffs[p * taps + k] / sum);
+    }
+}
+
+void LevelMeter::prepare(int numChannels, int maxBlockSize)
+{
+    channels = juce::jlimit(1, kMaxChannels, numChannels);
+    maxSection = juce::jmax(kFrameLength, maxBlockSize);
+
+    for (auto& s : stitched)
+        s.assign(static_cast<size_t>(kHistory + maxSection), 0.0f);
+
+    frameSums.assign(static_cast<size_t>(maxSection / kFrameLength + 2), 0.0f);
+
+    reset();
+}
+
+void LevelMeter::reset()
+{
+    for (auto& s : stitched)
+        std::fill(s.begin(), s.end(), 0.0f);
+
+    framePhase = 0;
+    partialFrame = 0.0f;
+    beginBlock();
+}
+
+void LevelMeter::setTruePeakEnabled(bool shouldMeasureTruePeak)
+{
+    if (truePeak == shouldMeasureTruePeak)
+        return;
+
+    // History from before it was switched off is stale
+    for (auto& s : stitched)
+        std::fill(s.begin(), s.begin() + kHistory, 0.0f);
+
+    truePeak = shouldMeasureTruePeak;
+}
+
+void LevelMeter::beginBlock()
+{
+    for (auto& b : block)
+        b = {};
+    blockSamples = 0;
+    blockChannels = 0;
+}
+
+void LevelMeter::process(const float* const* channelData, int numChannels, int numSamples, LoudnessTracker* tracker)
+{
+    for (int start = 0; start < numSamples; start += maxSection)
+    {
+        const float* sections[kMaxChannels] = {};
+        for (int ch = 0; ch < juce::jmin(numChannels, kMaxChannels); ++ch)
+            sections[ch] = channelData[ch] + start;
+
+        processSection(sections, numChannels, juce::jmin(maxSection, numSamples - start), tracker);
+    }
+}
+
+void LevelMeter::processSection(const float* const* channelData, int numChannelsIn, int numSamples, LoudnessTracker* tracker)
+{
+    const int numChannels = juce::jmin(channels, numChannelsIn);
+    if (numChannels == 0 || numSamples == 0)
+        return;
+
+    const int numFrames = (framePhase + numSamples) / kFrameLength + 1;
+    std::fill(frameSums.begin(), frameSums.begin() + numFrames, 0.0f);
+    frameSums[0] = partialFrame;
+
+    const auto kernel = kernels.meter[truePeak ? 1 : 0];
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const float* data = channelData[ch];
+
+        if (truePeak)
+        {
+            // The FIR needs the previous section's last samples in front
+            auto& s = stitched[static_cast<size_t>(ch)];
+            std::copy(data, data + numSamples, s.begin() + kHistory);
+            data = s.data() + kHistory;
+            kernel(data, numSamples, coeffs, framePhase, kFrameLength, frameSums.data(), block[ch]);
+            std::copy(s.begin() + numSamples, s.begin() + numSamples + kHistory, s.begin());
+        }
+        else
+        {
+            kernel(data, numSamples, coeffs, framePhase, kFrameLength, frameSums.data(), block[ch]);
+        }
+    }
+
+    // Completed frames go to the tracker as mean square per channel
+    const int completed = (framePhase + numSamples) / kFrameLength;
+    const float frameScale = 1.0f / static_cast<float>(kFrameLength * numChannels);
+
+    if (tracker != nullptr)
+        for (int f = 0; f < completed; ++f)
+            tracker->addFrame(frameSums[static_cast<size_t>(f)] * frameScale);
+
+    framePhase = (framePhase + numSamples) % kFrameLength;
+    partialFrame = framePhase > 0 ? frameSums[static_cast<size_t>(completed)] : 0.0f;
+    blockSamples += numSamples;
+    blockChannels = juce::jmax(blockChannels, numChannels);
+}
+
+float LevelMeter::getBlockRms() const
+{
+    if (blockSamples == 0 || blockChannels == 0)
+        return 0.0f;
+
+    float rms = 0.0f;
+    for (int ch = 0; ch < blockChannels; ++ch)
+        rms += static_cast<float>(std::sqrt(block[ch].sumSquares / blockSamples));
+
+    return rms / static_cast<float>(blockChannels);
+}
+
+float LevelMeter::getBlockPeak() const
+{
+    float peak = 0.0f;
+    for (int ch = 0; ch < channels; ++ch)
+        peak = juce::jmax(peak, block[ch].peak);
+    return peak;
+}
+
+float LevelMeter::getBlockTruePeak() const
+{
+    float peak = 0.0f;
+    for (int ch = 0; ch < channels; ++ch)
+        peak = juce::jmax(peak, block[ch].truePeak);
+    return peak;
+}
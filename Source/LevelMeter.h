@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "DspKernels.h"
+#include "LoudnessTracker.h"
+
+#include <vector>
+
+/**
+ * Fused level metering for one point in the signal chain.
+ *
+ * One kernel pass per channel gives the sum of squares, the sample peak and
+ * optionally the 4x true peak (DspKernels::meter). From those results:
+ *  - block levels (RMS / peak / true peak since beginBlock()) for the
+ *    visualizer and the UI meters
+ *  - mean square per LoudnessTracker control period, pushed into a tracker
+ *    for auto gain
+ * Frames are counted across process() calls, so the tracker sees the same
+ * periods at any host or chunk size.
+ */
+class LevelMeter
+{
+public:
+    static constexpr int kFrameLength = LoudnessTracker::kControlInterval;
+
+    LevelMeter();
+
+    /** maxBlockSize only sizes scratch buffers, process() accepts any length. */
+    void prepare(int numChannels, int maxBlockSize);
+    void reset();
+
+    /** The 4x true peak costs a 48-tap polyphase FIR per sample, so it is opt-in. */
+    void setTruePeakEnabled(bool shouldMeasureTruePeak);
+
+    /** Starts a new set of block levels. */
+    void beginBlock();
+
+    /** Measures the samples and feeds completed frames to tracker (if not nullptr). */
+    void process(const float* const* channelData, int numChannels, int numSamples, LoudnessTracker* tracker);
+
+    /** Levels since beginBlock(), averaged (RMS) or maxed (peaks) over channels. */
+    float getBlockRms() const;
+    float getBlockPeak() const;
+    float getBlockTruePeak() const;
+
+private:
+    static constexpr int kMaxChannels = 2;
+    static constexpr int kHistory = DspKernels::kTruePeakTaps - 1;
+
+    void processSection(const float* const* channelData, int numChannels, int numSamples, LoudnessTracker* tracker);
+
+    const DspKernels::KernelTable& kernels;
+    float coeffs[DspKernels::kTruePeakPhases * DspKernels::kTruePeakTaps];
+
+    int channels = 2;
+    int maxSection = 0;
+    bool truePeak = false;
+
+    // True-peak input: kHistory samples of the previous section, then the current one
+    std::vector<float> stitched[kMaxChannels];
+    std::vector<float> frameSums;
+    int framePhase = 0;
+    float partialFrame = 0.0f;  // squares of the frame still being filled
+
+    DspKernels::MeterResult block[kMaxChannels];
+    int blockSamples = 0;
+    int blockChannels = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeter)
+};
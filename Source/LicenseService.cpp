@@ -0,0 +1,161 @@
+#include "LicenseService.h"
+
+LicenseService::LicenseService()
+{
+    // Nothing touches the disk or network here - see start()
+}
+
+LicenseService::~LicenseService()
+{
+    worker.removeAllJobs(true, 5000);
+}
+
+bool LicenseService::isEnabled() const
+{
+#if HAS_PROJECT_DATA && BEATCONNECT_ACTIVATION_ENABLED
+    const auto& config = sharedResources->getProjectConfig();
+    return static_cast<bool>(config.buildFlags.getProperty("enableActivationKeys", false))
+        && config.pluginId.isNotEmpty();
+#else
+    return false;
+#endif
+}
+
+void LicenseService::start()
+{
+    if (!isEnabled() || started.exchange(true))
+        return;
+
+    validating.store(true, std::memory_order_release);
+
+    worker.addJob([this]
+    {
+        readCache();
+        sendChangeMessage();
+
+        createActivation();
+
+        validating.store(false, std::memory_order_release);
+        sendChangeMessage();
+    });
+}
+
+LicenseService::CachedState LicenseService::getCachedState() const
+{
+    const juce::SpinLock::ScopedLockType lock(stateLock);
+    return cachedState;
+}
+
+void LicenseService::refreshCacheAsync()
+{
+    worker.addJob([this]
+    {
+        updateCacheFromActivation();
+        sendChangeMessage();
+    });
+}
+
+juce::File LicenseService::getCacheFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("BeatConnect").getChildFile("DRIVE").getChildFile("Cache")
+        .getChildFile("LicenseState.json");
+}
+
+void LicenseService::readCache()
+{
+    const auto parsed = juce::JSON::parse(getCacheFile());
+    if (!parsed.isObject())
+        return;
+
+    // A cache from another product (or build) says nothing about this one
+    if (parsed.getProperty("pluginId", "").toString() != sharedResources->getProjectConfig().pluginId)
+        return;
+
+    CachedState state;
+    state.known = true;
+    state.activated = parsed.getProperty("activated", false);
+    state.activationCode = parsed.getProperty("activationCode", "").toString();
+    state.machineId = parsed.getProperty("machineId", "").toString();
+    state.activatedAt = parsed.getProperty("activatedAt", "").toString();
+    state.currentActivations = parsed.getProperty("currentActivations", 0);
+    state.maxActivations = parsed.getProperty("maxActivations", 0);
+    state.isValid = parsed.getProperty("isValid", false);
+    state.validatedAt = static_cast<juce::int64>(parsed.getProperty("validatedAt", 0));
+
+    const juce::SpinLock::ScopedLockType lock(stateLock);
+    cachedState = state;
+}
+
+void LicenseService::createActivation()
+{
+#if HAS_PROJECT_DATA && BEATCONNECT_ACTIVATION_ENABLED
+    const auto& config = sharedResources->getProjectConfig();
+
+    auto apiBaseUrl = juce::SystemStats::getEnvironmentVariable("DRIVE_LICENSE_SERVER", {});
+    if (apiBaseUrl.isEmpty())
+        apiBaseUrl = config.apiBaseUrl;
+
+    beatconnect::ActivationConfig activationConfig;
+    activationConfig.apiBaseUrl = apiBaseUrl.toStdString();
+    activationConfig.pluginId = config.pluginId.toStdString();
+    activationConfig.supabaseKey = config.supabaseKey.toStdString();
+    activationConfig.validateOnStartup = true;
+    activationConfig.revalidateIntervalSeconds = 86400; // Daily revalidation
+
+    const auto startMs = juce::Time::getMillisecondCounterHiRes();
+    activationStorage = beatconnect::Activation::create(activationConfig);
+    activation.store(activationStorage.get(), std::memory_order_release);
+
+    DBG("Activation system configured in " + juce::String(juce::Time::getMillisecondCounterHiRes() - startMs, 1) + " ms");
+
+    updateCacheFromActivation();
+#endif
+}
+
+void LicenseService::updateCacheFromActivation()
+{
+#if BEATCONNECT_ACTIVATION_ENABLED
+    auto* act = getActivation();
+    if (act == nullptr)
+        return;
+
+    CachedState state;
+    state.known = true;
+    state.activated = act->isActivated();
+    state.validatedAt = juce::Time::currentTimeMillis();
+
+    if (state.activated)
+    {
+        if (auto info = act->getActivationInfo())
+        {
+            state.activationCode = juce::String(info->activationCode);
+            state.machineId = juce::String(info->machineId);
+            state.activatedAt = juce::String(info->activatedAt);
+            state.currentActivations = info->currentActivations;
+            state.maxActivations = info->maxActivations;
+            state.isValid = info->isValid;
+        }
+    }
+
+    {
+        const juce::SpinLock::ScopedLockType lock(stateLock);
+        cachedState = state;
+    }
+
+    juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+    obj->setProperty("pluginId", sharedResources->getProjectConfig().pluginId);
+    obj->setProperty("activated", state.activated);
+    obj->setProperty("activationCode", state.activationCode);
+    obj->setProperty("machineId", state.machineId);
+    obj->setProperty("activatedAt", state.activatedAt);
+    obj->setProperty("currentActivations", state.currentActivations);
+    obj->setProperty("maxActivations", state.maxActivations);
+    obj->setProperty("isValid", state.isValid);
+    obj->setProperty("validatedAt", state.validatedAt);
+
+    const auto file = getCacheFile();
+    file.getParentDirectory().createDirectory();
+    file.replaceWithText(juce::JSON::toString(juce::var(obj.get())));
+#endif
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include "SharedResources.h"
+
+#include <atomic>
+#include <memory>
+
+#if BEATCONNECT_ACTIVATION_ENABLED
+#include <beatconnect/Activation.h>
+#endif
+
+/**
+ * Process-wide license state, kept off the plugin instantiation path.
+ *
+ * Instances hold it through juce::SharedResourcePointer and constructing it
+ * does no I/O. The first start() (editor opened or playback prepared) queues
+ * the work on the service's background thread: read the cached result of the
+ * last validation, create the beatconnect::Activation (which validates
+ * online), and write the new result back to the cache. Until validation has
+ * finished, getCachedState() reports the last known state so the UI can show
+ * it straight away. A change message is broadcast whenever the state changes.
+ *
+ * DRIVE_LICENSE_SERVER overrides the API base URL, e.g. to point the SDK at
+ * DriveLicenseStubServer in tests.
+ */
+class LicenseService : public juce::ChangeBroadcaster
+{
+public:
+    LicenseService();
+    ~LicenseService() override;
+
+    /** True if this build has activation keys enabled and a plugin id. */
+    bool isEnabled() const;
+
+    /** Starts activation in the background. Cheap, and only the first call does anything. */
+    void start();
+
+    /** True from start() until the first online validation has finished. */
+    bool isValidating() const { return validating.load(std::memory_order_acquire); }
+
+    /** Result of the last validation, from the cache file until the SDK has answered. */
+    struct CachedState
+    {
+        bool known = false;
+        bool activated = false;
+        juce::String activationCode;
+        juce::String machineId;
+        juce::String activatedAt;
+        int currentActivations = 0;
+        int maxActivations = 0;
+        bool isValid = false;
+        juce::int64 validatedAt = 0;  // ms since epoch
+    };
+
+    CachedState getCachedState() const;
+
+    /** Re-reads the activation state and rewrites the cache (after activating/deactivating). */
+    void refreshCacheAsync();
+
+#if BEATCONNECT_ACTIVATION_ENABLED
+    /** nullptr until the background start has created it. */
+    beatconnect::Activation* getActivation() const { return activation.load(std::memory_order_acquire); }
+#endif
+
+    static juce::File getCacheFile();
+
+private:
+    void createActivation();
+    void readCache();
+    void updateCacheFromActivation();
+
+    juce::SharedResourcePointer<SharedResources> sharedResources;
+
+    std::atomic<bool> started { false };
+    std::atomic<bool> validating { false };
+
+    mutable juce::SpinLock stateLock;
+    CachedState cachedState;
+
+#if BEATCONNECT_ACTIVATION_ENABLED
+    std::unique_ptr<beatconnect::Activation> activationStorage;
+    std::atomic<beatconnect::Activation*> activation { nullptr };
+#endif
+
+    // Declared last so it is destroyed (and finishes its jobs) first
+    juce::ThreadPool worker { 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LicenseService)
+};
@@ -0,0 +1,26 @@
+#include "LoudnessTracker.h"
+
+void LoudnessTracker::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    updateCoefficients();
+    reset();
+}
+
+void LoudnessTracker::reset()
+{
+    meanSquare = 0.0f;
+}
+
+void LoudnessTracker::setTimeConstant(float seconds)
+{
+    timeConstant = juce::jmax(0.001f, seconds);
+    updateCoefficients();
+}
+
+void LoudnessTracker::updateCoefficients()
+{
+    const double controlPeriod = kControlInterval / sampleRate;
+    coeff = static_cast<float>(1.0 - std::exp(-controlPeriod / timeConstant));
+}
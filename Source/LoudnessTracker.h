@@ -0,0 +1,40 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+/**
+ * Mean-square loudness tracker with time constants in seconds.
+ *
+ * The caller measures the energy of every sample over a control period of
+ * kControlInterval samples (LevelMeter does, for the engine's auto gain)
+ * and pushes one mean square per period with addFrame(), so the result does
+ * not depend on the host buffer size. (The period sum is the anti-aliasing
+ * filter: taking every Nth sample's square instead reads sines near
+ * multiples of fs / 2N too high or too low.)
+ */
+class LoudnessTracker
+{
+public:
+    static constexpr int kControlInterval = 32; // samples per control tick
+
+    void prepare(double sampleRate);
+    void reset();
+
+    /** Integration time constant in seconds. */
+    void setTimeConstant(float seconds);
+
+    /** One control period's mean square (per channel), measured by the caller. */
+    void addFrame(float frameMeanSquare) { meanSquare += (frameMeanSquare - meanSquare) * coeff; }
+
+    /** Smoothed mean square, summed over channels and divided by the channel count. */
+    float getMeanSquare() const { return meanSquare; }
+
+private:
+    void updateCoefficients();
+
+    double sampleRate = 44100.0;
+    float timeConstant = 0.4f;
+
+    float coeff = 0.0f;         // one-pole coefficient per control tick
+    float meanSquare = 0.0f;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+/**
+ * Worker threads for offline (non-realtime) rendering, shared by all
+ * instances in the process via juce::SharedResourcePointer.
+ *
+ * Only used while the host reports isNonRealtime(); realtime processing never
+ * touches it. One thread fewer than the number of cores, since the host's
+ * render thread does its share of the work too.
+ */
+class OfflineRenderPool
+{
+public:
+    OfflineRenderPool()
+        : pool(juce::jmax(1, juce::SystemStats::getNumCpus() - 1))
+    {
+    }
+
+    juce::ThreadPool& getPool() { return pool; }
+
+private:
+    juce::ThreadPool pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderPool)
+};
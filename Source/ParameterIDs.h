@@ -17,6 +17,43 @@ namespace ParameterIDs
     inline constexpr const char* autoGain     = "autoGain";     // Auto gain compensation
     inline constexpr const char* stereoWidth  = "stereoWidth";  // Stereo width
     inline constexpr const char* bypass       = "bypass";       // Master bypass
+    inline constexpr const char* ceilingMode  = "ceilingMode";  // True-peak output stage: 0=Off, 1=Clip, 2=Limit
+    inline constexpr const char* ceiling      = "ceiling";      // True-peak ceiling (dBTP)
+    inline constexpr const char* oversampling = "oversampling"; // Saturation oversampling: 0=1x, 1=2x, 2=4x
+    inline constexpr const char* adaa         = "adaa";         // Antiderivative anti-aliasing for the saturation
+    inline constexpr const char* adaptiveQuality = "adaptiveQuality"; // Lower oversampling under CPU load / high base rates
+
+    // Fixed parameter order of the binary state format (see StateSerializer).
+    // Only ever APPEND to this list - each index is part of the saved layout.
+    inline constexpr const char* stateOrder[] = {
+        drive, pressure, tone, mix, output,
+        mode, attack, sustain, sidechainHp, autoGain, stereoWidth, bypass,
+        ceilingMode, ceiling,
+        oversampling, adaa,
+        adaptiveQuality
+    };
+    inline constexpr int numStateParameters = static_cast<int>(sizeof(stateOrder) / sizeof(stateOrder[0]));
+
+    // Session settings rather than part of the sound: the host's bypass
+    // switch, the output ceiling and the CPU/quality trade-off. Presets
+    // neither save nor load them, so changing preset keeps them as they are
+    inline constexpr const char* sessionParameters[] = {
+        bypass, ceilingMode, ceiling, oversampling, adaa, adaptiveQuality
+    };
+
+    /** False for the sessionParameters, true for everything a preset carries. */
+    constexpr bool isPresetParameter(const char* id)
+    {
+        for (const char* session : sessionParameters)
+        {
+            int i = 0;
+            while (session[i] != 0 && session[i] == id[i])
+                ++i;
+            if (session[i] == id[i])
+                return false;
+        }
+        return true;
+    }
 
     // Parameter ranges
     namespace Ranges
@@ -68,5 +105,16 @@ namespace ParameterIDs
         inline constexpr float stereoWidthMin = 0.0f;
         inline constexpr float stereoWidthMax = 200.0f;
         inline constexpr float stereoWidthDefault = 100.0f;
+
+        // Ceiling mode: 0=Off, 1=Clip, 2=Limit
+        inline constexpr int ceilingModeDefault = 0;
+
+        // Ceiling: -12 to 0 dBTP
+        inline constexpr float ceilingMin = -12.0f;
+        inline constexpr float ceilingMax = 0.0f;
+        inline constexpr float ceilingDefault = -1.0f;
+
+        // Oversampling: 0=1x, 1=2x, 2=4x
+        inline constexpr int oversamplingDefault = 2;
     }
 }
@@ -1,7 +1,24 @@
 #include "PluginEditor.h"
 #include "ParameterIDs.h"
+#include "KernelDispatch.h"
 #include <thread>
 
+namespace
+{
+    bool isAdaptiveQualityOn(DriveAudioProcessor& processor)
+    {
+        return processor.getAPVTS().getRawParameterValue(ParameterIDs::adaptiveQuality)->load() > 0.5f;
+    }
+
+    /** Changes whenever the quality part of the engine info does. */
+    int getQualityKey(DriveAudioProcessor& processor)
+    {
+        const auto quality = processor.getActiveQuality();
+        return quality.oversamplingStages * 8 + (quality.adaa ? 4 : 0) + (quality.reduced ? 2 : 0)
+             + (isAdaptiveQualityOn(processor) ? 1 : 0);
+    }
+}
+
 DriveAudioProcessorEditor::DriveAudioProcessorEditor(DriveAudioProcessor& p)
     : AudioProcessorEditor(&p), audioProcessor(p)
 {
@@ -14,6 +31,16 @@ DriveAudioProcessorEditor::DriveAudioProcessorEditor(DriveAudioProcessor& p)
     setSize(900, 500);
     setResizable(false, false);
 
+    audioProcessor.getPresetLibrary().addChangeListener(this);
+
+    // The license UI needs the activation state: start it now if playback
+    // hasn't already
+    audioProcessor.getLicenseService().addChangeListener(this);
+    audioProcessor.getLicenseService().start();
+
+    // True-peak meters only run while they're on screen
+    audioProcessor.setTruePeakMetering(true);
+
     // Start timer for visualizer updates (60fps)
     startTimerHz(60);
 }
@@ -21,8 +48,13 @@ DriveAudioProcessorEditor::DriveAudioProcessorEditor(DriveAudioProcessor& p)
 DriveAudioProcessorEditor::~DriveAudioProcessorEditor()
 {
     stopTimer();
+    audioProcessor.setTruePeakMetering(false);
+    audioProcessor.getPresetLibrary().removeChangeListener(this);
+    audioProcessor.getLicenseService().removeChangeListener(this);
 
-    // Destroy attachments first (they reference relays)
+    // Write any value still pending from the web UI, then destroy
+    // attachments (they reference relays)
+    flushRelayUpdates();
     driveAttachment.reset();
     pressureAttachment.reset();
     toneAttachment.reset();
@@ -31,8 +63,13 @@ DriveAudioProcessorEditor::~DriveAudioProcessorEditor()
     modeAttachment.reset();
     attackAttachment.reset();
     sustainAttachment.reset();
+    ceilingModeAttachment.reset();
+    ceilingAttachment.reset();
     autoGainAttachment.reset();
     bypassAttachment.reset();
+    oversamplingAttachment.reset();
+    adaaAttachment.reset();
+    adaptiveQualityAttachment.reset();
 
     // Destroy WebView (disconnects relay bindings)
     webView.reset();
@@ -51,69 +88,32 @@ void DriveAudioProcessorEditor::setupWebView()
     outputRelay = std::make_unique<juce::WebSliderRelay>("output");
     attackRelay = std::make_unique<juce::WebSliderRelay>("attack");
     sustainRelay = std::make_unique<juce::WebSliderRelay>("sustain");
+    ceilingRelay = std::make_unique<juce::WebSliderRelay>("ceiling");
 
-    // ComboBox relay for choice parameter (mode)
+    // ComboBox relays for choice parameters (mode, ceiling mode, oversampling)
     modeRelay = std::make_unique<juce::WebComboBoxRelay>("mode");
+    ceilingModeRelay = std::make_unique<juce::WebComboBoxRelay>("ceilingMode");
+    oversamplingRelay = std::make_unique<juce::WebComboBoxRelay>("oversampling");
 
     // Toggle relays for boolean parameters
     autoGainRelay = std::make_unique<juce::WebToggleButtonRelay>("autoGain");
     bypassRelay = std::make_unique<juce::WebToggleButtonRelay>("bypass");
+    adaaRelay = std::make_unique<juce::WebToggleButtonRelay>("adaa");
+    adaptiveQualityRelay = std::make_unique<juce::WebToggleButtonRelay>("adaptiveQuality");
 
-    // Get resources directory - handle both Standalone and VST3 paths
-    auto executableFile = juce::File::getSpecialLocation(juce::File::currentExecutableFile);
-    auto executableDir = executableFile.getParentDirectory();
-
-    // Try Standalone path first: executable/../Resources/WebUI
-    resourcesDir = executableDir.getChildFile("Resources").getChildFile("WebUI");
-
-    // If that doesn't exist, try VST3 path: executable/../../Resources/WebUI
-    if (!resourcesDir.isDirectory())
-    {
-        resourcesDir = executableDir.getParentDirectory()
-                           .getChildFile("Resources")
-                           .getChildFile("WebUI");
-    }
-
-    DBG("Resources dir: " + resourcesDir.getFullPathName());
-    DBG("Resources exist: " + juce::String(resourcesDir.isDirectory() ? "yes" : "no"));
-
-    // Build WebBrowserComponent options
+    // Build WebBrowserComponent options. Web UI files are read from disk once
+    // per process and shared by every editor (SharedResources)
     auto options = juce::WebBrowserComponent::Options()
         .withBackend(juce::WebBrowserComponent::Options::Backend::webview2)
         .withNativeIntegrationEnabled()
         .withResourceProvider(
             [this](const juce::String& url) -> std::optional<juce::WebBrowserComponent::Resource>
             {
-                // The url parameter is just the path like "/" or "/assets/index.js"
-                auto path = url;
-                if (path.startsWith("/"))
-                    path = path.substring(1);
-                if (path.isEmpty())
-                    path = "index.html";
-
-                auto file = resourcesDir.getChildFile(path);
-                if (!file.existsAsFile())
+                auto resource = audioProcessor.getSharedResources().getWebResource(url);
+                if (resource == nullptr)
                     return std::nullopt;
 
-                // Determine MIME type
-                juce::String mimeType = "application/octet-stream";
-                if (path.endsWith(".html")) mimeType = "text/html";
-                else if (path.endsWith(".css")) mimeType = "text/css";
-                else if (path.endsWith(".js")) mimeType = "application/javascript";
-                else if (path.endsWith(".json")) mimeType = "application/json";
-                else if (path.endsWith(".png")) mimeType = "image/png";
-                else if (path.endsWith(".svg")) mimeType = "image/svg+xml";
-                else if (path.endsWith(".woff2")) mimeType = "font/woff2";
-
-                juce::MemoryBlock data;
-                file.loadFileAsData(data);
-
-                return juce::WebBrowserComponent::Resource{
-                    std::vector<std::byte>(
-                        reinterpret_cast<const std::byte*>(data.getData()),
-                        reinterpret_cast<const std::byte*>(data.getData()) + data.getSize()),
-                    mimeType.toStdString()
-                };
+                return juce::WebBrowserComponent::Resource{ resource->data, resource->mimeType.toStdString() };
             })
         .withOptionsFrom(*driveRelay)
         .withOptionsFrom(*pressureRelay)
@@ -123,19 +123,56 @@ void DriveAudioProcessorEditor::setupWebView()
         .withOptionsFrom(*modeRelay)
         .withOptionsFrom(*attackRelay)
         .withOptionsFrom(*sustainRelay)
+        .withOptionsFrom(*ceilingModeRelay)
+        .withOptionsFrom(*ceilingRelay)
         .withOptionsFrom(*autoGainRelay)
         .withOptionsFrom(*bypassRelay)
+        .withOptionsFrom(*oversamplingRelay)
+        .withOptionsFrom(*adaaRelay)
+        .withOptionsFrom(*adaptiveQualityRelay)
         .withEventListener("requestVisualizerData", [this](const juce::var&) {
+            DRIVE_TRACE_SCOPE("event: requestVisualizerData", "message");
             sendVisualizerData();
         })
+        .withEventListener("resetSanitizerCounters", [this](const juce::var&) {
+            DRIVE_TRACE_SCOPE("event: resetSanitizerCounters", "message");
+            audioProcessor.resetSanitizerCounters();
+        })
+        .withEventListener("requestEngineInfo", [this](const juce::var&) {
+            DRIVE_TRACE_SCOPE("event: requestEngineInfo", "message");
+            sendEngineInfo();
+        })
+        .withEventListener("requestMemoryReport", [this](const juce::var&) {
+            DRIVE_TRACE_SCOPE("event: requestMemoryReport", "message");
+            sendMemoryReport();
+        })
+        .withEventListener("queryPresets", [this](const juce::var& data) {
+            DRIVE_TRACE_SCOPE("event: queryPresets", "message");
+            handleQueryPresets(data);
+        })
+        .withEventListener("loadPreset", [this](const juce::var& data) {
+            DRIVE_TRACE_SCOPE("event: loadPreset", "message");
+            handleLoadPreset(data);
+        })
+        .withEventListener("stepPreset", [this](const juce::var& data) {
+            DRIVE_TRACE_SCOPE("event: stepPreset", "message");
+            handleStepPreset(data);
+        })
+        .withEventListener("savePreset", [this](const juce::var& data) {
+            DRIVE_TRACE_SCOPE("event: savePreset", "message");
+            handleSavePreset(data);
+        })
 #if BEATCONNECT_ACTIVATION_ENABLED
         .withEventListener("activateLicense", [this](const juce::var& data) {
+            DRIVE_TRACE_SCOPE("event: activateLicense", "message");
             handleActivateLicense(data);
         })
         .withEventListener("deactivateLicense", [this](const juce::var& data) {
+            DRIVE_TRACE_SCOPE("event: deactivateLicense", "message");
             handleDeactivateLicense(data);
         })
         .withEventListener("getActivationStatus", [this](const juce::var&) {
+            DRIVE_TRACE_SCOPE("event: getActivationStatus", "message");
             handleGetActivationStatus();
         })
 #endif
@@ -168,42 +205,72 @@ void DriveAudioProcessorEditor::setupRelaysAndAttachments()
     auto& apvts = audioProcessor.getAPVTS();
 
     // Slider attachments for continuous parameters
-    driveAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+    driveAttachment = std::make_unique<CoalescedSliderAttachment>(
         *apvts.getParameter(ParameterIDs::drive), *driveRelay, nullptr);
 
-    pressureAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+    pressureAttachment = std::make_unique<CoalescedSliderAttachment>(
         *apvts.getParameter(ParameterIDs::pressure), *pressureRelay, nullptr);
 
-    toneAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+    toneAttachment = std::make_unique<CoalescedSliderAttachment>(
         *apvts.getParameter(ParameterIDs::tone), *toneRelay, nullptr);
 
-    mixAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+    mixAttachment = std::make_unique<CoalescedSliderAttachment>(
         *apvts.getParameter(ParameterIDs::mix), *mixRelay, nullptr);
 
-    outputAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+    outputAttachment = std::make_unique<CoalescedSliderAttachment>(
         *apvts.getParameter(ParameterIDs::output), *outputRelay, nullptr);
 
-    attackAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+    attackAttachment = std::make_unique<CoalescedSliderAttachment>(
         *apvts.getParameter(ParameterIDs::attack), *attackRelay, nullptr);
 
-    sustainAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+    sustainAttachment = std::make_unique<CoalescedSliderAttachment>(
         *apvts.getParameter(ParameterIDs::sustain), *sustainRelay, nullptr);
 
-    // ComboBox attachment for choice parameter (mode)
+    ceilingAttachment = std::make_unique<CoalescedSliderAttachment>(
+        *apvts.getParameter(ParameterIDs::ceiling), *ceilingRelay, nullptr);
+
+    // ComboBox attachments for choice parameters (mode, ceiling mode, oversampling)
     modeAttachment = std::make_unique<juce::WebComboBoxParameterAttachment>(
         *apvts.getParameter(ParameterIDs::mode), *modeRelay, nullptr);
 
+    ceilingModeAttachment = std::make_unique<juce::WebComboBoxParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::ceilingMode), *ceilingModeRelay, nullptr);
+
+    oversamplingAttachment = std::make_unique<juce::WebComboBoxParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::oversampling), *oversamplingRelay, nullptr);
+
     // Toggle attachments for boolean parameters
     autoGainAttachment = std::make_unique<juce::WebToggleButtonParameterAttachment>(
         *apvts.getParameter(ParameterIDs::autoGain), *autoGainRelay, nullptr);
 
     bypassAttachment = std::make_unique<juce::WebToggleButtonParameterAttachment>(
         *apvts.getParameter(ParameterIDs::bypass), *bypassRelay, nullptr);
+
+    adaaAttachment = std::make_unique<juce::WebToggleButtonParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::adaa), *adaaRelay, nullptr);
+
+    adaptiveQualityAttachment = std::make_unique<juce::WebToggleButtonParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::adaptiveQuality), *adaptiveQualityRelay, nullptr);
 }
 
 void DriveAudioProcessorEditor::timerCallback()
 {
+    DRIVE_TRACE_SCOPE("timerCallback", "message");
+    flushRelayUpdates();
     sendVisualizerData();
+
+    // Adaptive quality can change the tier at any time
+    if (getQualityKey(audioProcessor) != lastQualityKey)
+        sendEngineInfo();
+}
+
+void DriveAudioProcessorEditor::flushRelayUpdates()
+{
+    for (auto* attachment : { driveAttachment.get(), pressureAttachment.get(), toneAttachment.get(),
+                              mixAttachment.get(), outputAttachment.get(), attackAttachment.get(),
+                              sustainAttachment.get(), ceilingAttachment.get() })
+        if (attachment != nullptr)
+            attachment->flush();
 }
 
 void DriveAudioProcessorEditor::sendVisualizerData()
@@ -211,12 +278,22 @@ void DriveAudioProcessorEditor::sendVisualizerData()
     if (webView == nullptr)
         return;
 
+    DRIVE_TRACE_SCOPE("sendVisualizerData", "message");
     auto& apvts = audioProcessor.getAPVTS();
 
     juce::DynamicObject::Ptr data = new juce::DynamicObject();
     data->setProperty("rms", audioProcessor.getCurrentRMS());
     data->setProperty("peak", audioProcessor.getCurrentPeak());
     data->setProperty("envelope", audioProcessor.getEnvelopeFollower());
+    data->setProperty("truePeak", audioProcessor.getCurrentTruePeak());
+    data->setProperty("outputRms", audioProcessor.getOutputRMS());
+    data->setProperty("outputPeak", audioProcessor.getOutputPeak());
+    data->setProperty("outputTruePeak", audioProcessor.getOutputTruePeak());
+
+    // Sanitizer counters, so a misbehaving upstream plugin shows up in the UI
+    data->setProperty("sanitizedNonFinite", static_cast<juce::int64>(audioProcessor.getSanitizedNonFinite()));
+    data->setProperty("sanitizedDenormals", static_cast<juce::int64>(audioProcessor.getSanitizedDenormals()));
+    data->setProperty("stateResets", static_cast<juce::int64>(audioProcessor.getStateResets()));
 
     // Debug: send current parameter values so we can see them in browser console
     data->setProperty("debug_drive", apvts.getRawParameterValue("drive")->load());
@@ -227,34 +304,163 @@ void DriveAudioProcessorEditor::sendVisualizerData()
     webView->emitEventIfBrowserIsVisible("visualizerData", juce::var(data.get()));
 }
 
+void DriveAudioProcessorEditor::sendEngineInfo()
+{
+    if (webView == nullptr)
+        return;
+
+    const auto quality = audioProcessor.getActiveQuality();
+    lastQualityKey = getQualityKey(audioProcessor);
+
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("kernelIsa", KernelDispatch::getLevelName(KernelDispatch::getActiveLevel()));
+    data->setProperty("oversampling", 1 << quality.oversamplingStages);
+    data->setProperty("adaa", quality.adaa);
+    data->setProperty("adaptiveQuality", isAdaptiveQualityOn(audioProcessor));
+    data->setProperty("qualityReduced", quality.reduced);
+
+    webView->emitEventIfBrowserIsVisible("engineInfo", juce::var(data.get()));
+}
+
+void DriveAudioProcessorEditor::sendMemoryReport()
+{
+    if (webView == nullptr)
+        return;
+
+    const auto report = audioProcessor.getMemoryReport();
+
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("instanceBytes", static_cast<juce::int64>(report.instanceBytes));
+    data->setProperty("sharedBytes", static_cast<juce::int64>(report.sharedBytes));
+    data->setProperty("sharingInstances", report.sharingInstances);
+    data->setProperty("savedBytes", static_cast<juce::int64>(report.savedBytes));
+
+    webView->emitEventIfBrowserIsVisible("memoryReport", juce::var(data.get()));
+}
+
+void DriveAudioProcessorEditor::handleQueryPresets(const juce::var& data)
+{
+    const int requestId = data.getProperty("requestId", 0);
+    const juce::String query = data.getProperty("query", "").toString();
+    const int offset = data.getProperty("offset", 0);
+    const int limit = data.getProperty("limit", 200);
+
+    juce::Component::SafePointer<DriveAudioProcessorEditor> safeThis(this);
+
+    audioProcessor.getPresetLibrary().queryAsync(query, offset, limit,
+        [safeThis, requestId, offset](PresetLibrary::QueryResult result) {
+            if (safeThis == nullptr || safeThis->webView == nullptr)
+                return;
+
+            juce::Array<juce::var> presets;
+            for (const auto& entry : result.entries)
+            {
+                juce::DynamicObject::Ptr preset = new juce::DynamicObject();
+                preset->setProperty("id", entry.key);
+                preset->setProperty("name", entry.name);
+                preset->setProperty("tags", entry.tags);
+                preset->setProperty("factory", entry.isFactory);
+                presets.add(juce::var(preset.get()));
+            }
+
+            juce::DynamicObject::Ptr response = new juce::DynamicObject();
+            response->setProperty("requestId", requestId);
+            response->setProperty("offset", offset);
+            response->setProperty("total", result.totalMatches);
+            response->setProperty("presets", presets);
+            response->setProperty("current", safeThis->audioProcessor.getCurrentPresetKey());
+
+            safeThis->webView->emitEventIfBrowserIsVisible("presetResults", juce::var(response.get()));
+        });
+}
+
+void DriveAudioProcessorEditor::handleLoadPreset(const juce::var& data)
+{
+    loadPresetAndNotify(data.getProperty("id", "").toString());
+}
+
+void DriveAudioProcessorEditor::handleStepPreset(const juce::var& data)
+{
+    const int delta = data.getProperty("delta", 1);
+    const auto& library = audioProcessor.getPresetLibrary();
+    loadPresetAndNotify(library.getAdjacentPresetKey(audioProcessor.getCurrentPresetKey(), delta));
+}
+
+void DriveAudioProcessorEditor::loadPresetAndNotify(const juce::String& key)
+{
+    if (!audioProcessor.loadPreset(key) || webView == nullptr)
+        return;
+
+    juce::DynamicObject::Ptr result = new juce::DynamicObject();
+    result->setProperty("id", key);
+    result->setProperty("name", audioProcessor.getPresetLibrary().getPresetName(key));
+    webView->emitEventIfBrowserIsVisible("presetLoaded", juce::var(result.get()));
+}
+
+void DriveAudioProcessorEditor::handleSavePreset(const juce::var& data)
+{
+    const juce::String name = data.getProperty("name", "").toString().trim();
+    if (name.isEmpty())
+        return;
+
+    juce::Component::SafePointer<DriveAudioProcessorEditor> safeThis(this);
+
+    audioProcessor.saveUserPreset(name, data.getProperty("tags", "").toString(),
+        [safeThis, name](bool ok) {
+            if (safeThis == nullptr || safeThis->webView == nullptr)
+                return;
+
+            juce::DynamicObject::Ptr result = new juce::DynamicObject();
+            result->setProperty("name", name);
+            result->setProperty("success", ok);
+            safeThis->webView->emitEventIfBrowserIsVisible("presetSaved", juce::var(result.get()));
+        });
+}
+
+void DriveAudioProcessorEditor::changeListenerCallback(juce::ChangeBroadcaster* source)
+{
+    if (webView == nullptr)
+        return;
+
+    if (source == &audioProcessor.getLicenseService())
+    {
+#if BEATCONNECT_ACTIVATION_ENABLED
+        sendActivationState();
+#endif
+        return;
+    }
+
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("total", audioProcessor.getPresetLibrary().getNumPresets());
+    webView->emitEventIfBrowserIsVisible("presetLibraryChanged", juce::var(data.get()));
+}
+
 #if BEATCONNECT_ACTIVATION_ENABLED
 void DriveAudioProcessorEditor::sendActivationState()
 {
     if (webView == nullptr)
         return;
 
-    auto* activation = audioProcessor.getActivation();
+    // Reports the cached result until the background validation has
+    // finished, then the live one (the service keeps both in sync)
+    auto& licenseService = audioProcessor.getLicenseService();
+    const auto state = licenseService.getCachedState();
     juce::DynamicObject::Ptr data = new juce::DynamicObject();
 
-    bool isConfigured = (activation != nullptr);
-    bool isActivated = isConfigured && activation->isActivated();
-
-    data->setProperty("isConfigured", isConfigured);
-    data->setProperty("isActivated", isActivated);
+    data->setProperty("isConfigured", licenseService.isEnabled());
+    data->setProperty("isActivated", state.activated);
+    data->setProperty("isPending", licenseService.isValidating());
 
-    if (isActivated && activation)
+    if (state.activated)
     {
-        if (auto info = activation->getActivationInfo())
-        {
-            juce::DynamicObject::Ptr infoObj = new juce::DynamicObject();
-            infoObj->setProperty("activationCode", juce::String(info->activationCode));
-            infoObj->setProperty("machineId", juce::String(info->machineId));
-            infoObj->setProperty("activatedAt", juce::String(info->activatedAt));
-            infoObj->setProperty("currentActivations", info->currentActivations);
-            infoObj->setProperty("maxActivations", info->maxActivations);
-            infoObj->setProperty("isValid", info->isValid);
-            data->setProperty("info", juce::var(infoObj.get()));
-        }
+        juce::DynamicObject::Ptr infoObj = new juce::DynamicObject();
+        infoObj->setProperty("activationCode", state.activationCode);
+        infoObj->setProperty("machineId", state.machineId);
+        infoObj->setProperty("activatedAt", state.activatedAt);
+        infoObj->setProperty("currentActivations", state.currentActivations);
+        infoObj->setProperty("maxActivations", state.maxActivations);
+        infoObj->setProperty("isValid", state.isValid);
+        data->setProperty("info", juce::var(infoObj.get()));
     }
 
     webView->emitEventIfBrowserIsVisible("activationState", juce::var(data.get()));
@@ -270,7 +476,13 @@ void DriveAudioProcessorEditor::handleActivateLicense(const juce::var& data)
 
     auto* activation = audioProcessor.getActivation();
     if (!activation)
+    {
+        // Still starting up in the background
+        juce::DynamicObject::Ptr result = new juce::DynamicObject();
+        result->setProperty("status", "pending");
+        webView->emitEventIfBrowserIsVisible("activationResult", juce::var(result.get()));
         return;
+    }
 
     activation->activateAsync(code.toStdString(),
         [safeThis](beatconnect::ActivationStatus status) {
@@ -278,6 +490,8 @@ void DriveAudioProcessorEditor::handleActivateLicense(const juce::var& data)
                 if (safeThis == nullptr || safeThis->webView == nullptr)
                     return;
 
+                safeThis->audioProcessor.getLicenseService().refreshCacheAsync();
+
                 juce::DynamicObject::Ptr result = new juce::DynamicObject();
 
                 juce::String statusStr;
@@ -334,6 +548,8 @@ void DriveAudioProcessorEditor::handleDeactivateLicense(const juce::var&)
             if (safeThis == nullptr || safeThis->webView == nullptr)
                 return;
 
+            safeThis->audioProcessor.getLicenseService().refreshCacheAsync();
+
             juce::DynamicObject::Ptr result = new juce::DynamicObject();
 
             juce::String statusStr;
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "PluginProcessor.h"
+#include "CoalescedSliderAttachment.h"
 #include <juce_gui_extra/juce_gui_extra.h>
 
 class DriveAudioProcessorEditor : public juce::AudioProcessorEditor,
-                                   private juce::Timer
+                                   private juce::Timer,
+                                   private juce::ChangeListener
 {
 public:
     explicit DriveAudioProcessorEditor(DriveAudioProcessor&);
@@ -17,7 +19,18 @@ private:
     void setupWebView();
     void setupRelaysAndAttachments();
     void timerCallback() override;
+    void flushRelayUpdates();
     void sendVisualizerData();
+    void sendMemoryReport();
+    void sendEngineInfo();
+
+    // Preset browser (queries run on the preset library's worker thread)
+    void handleQueryPresets(const juce::var& data);
+    void handleLoadPreset(const juce::var& data);
+    void handleStepPreset(const juce::var& data);
+    void loadPresetAndNotify(const juce::String& key);
+    void handleSavePreset(const juce::var& data);
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;  // presets and license state
 
 #if BEATCONNECT_ACTIVATION_ENABLED
     void sendActivationState();
@@ -28,9 +41,6 @@ private:
 
     DriveAudioProcessor& audioProcessor;
 
-    // Resources directory for bundled WebUI
-    juce::File resourcesDir;
-
     // JUCE 8 Relay system - created BEFORE WebBrowserComponent
     // Slider relays for continuous parameters
     std::unique_ptr<juce::WebSliderRelay> driveRelay;
@@ -40,27 +50,41 @@ private:
     std::unique_ptr<juce::WebSliderRelay> outputRelay;
     std::unique_ptr<juce::WebSliderRelay> attackRelay;
     std::unique_ptr<juce::WebSliderRelay> sustainRelay;
+    std::unique_ptr<juce::WebSliderRelay> ceilingRelay;
 
-    // ComboBox relay for choice parameter
+    // ComboBox relays for choice parameters
     std::unique_ptr<juce::WebComboBoxRelay> modeRelay;
+    std::unique_ptr<juce::WebComboBoxRelay> ceilingModeRelay;
+    std::unique_ptr<juce::WebComboBoxRelay> oversamplingRelay;
 
     // Toggle relays for boolean parameters
     std::unique_ptr<juce::WebToggleButtonRelay> autoGainRelay;
     std::unique_ptr<juce::WebToggleButtonRelay> bypassRelay;
+    std::unique_ptr<juce::WebToggleButtonRelay> adaaRelay;
+    std::unique_ptr<juce::WebToggleButtonRelay> adaptiveQualityRelay;
 
     // Parameter attachments - created AFTER WebBrowserComponent
-    std::unique_ptr<juce::WebSliderParameterAttachment> driveAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> pressureAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> toneAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> mixAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> outputAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> attackAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> sustainAttachment;
+    // Slider values from the web UI are coalesced and written once per timer tick
+    std::unique_ptr<CoalescedSliderAttachment> driveAttachment;
+    std::unique_ptr<CoalescedSliderAttachment> pressureAttachment;
+    std::unique_ptr<CoalescedSliderAttachment> toneAttachment;
+    std::unique_ptr<CoalescedSliderAttachment> mixAttachment;
+    std::unique_ptr<CoalescedSliderAttachment> outputAttachment;
+    std::unique_ptr<CoalescedSliderAttachment> attackAttachment;
+    std::unique_ptr<CoalescedSliderAttachment> sustainAttachment;
+    std::unique_ptr<CoalescedSliderAttachment> ceilingAttachment;
 
     std::unique_ptr<juce::WebComboBoxParameterAttachment> modeAttachment;
+    std::unique_ptr<juce::WebComboBoxParameterAttachment> ceilingModeAttachment;
+    std::unique_ptr<juce::WebComboBoxParameterAttachment> oversamplingAttachment;
 
     std::unique_ptr<juce::WebToggleButtonParameterAttachment> autoGainAttachment;
     std::unique_ptr<juce::WebToggleButtonParameterAttachment> bypassAttachment;
+    std::unique_ptr<juce::WebToggleButtonParameterAttachment> adaaAttachment;
+    std::unique_ptr<juce::WebToggleButtonParameterAttachment> adaptiveQualityAttachment;
+
+    // Quality tier last sent with the engine info, resent when it changes
+    int lastQualityKey = -1;
 
     // WebView component
     std::unique_ptr<juce::WebBrowserComponent> webView;
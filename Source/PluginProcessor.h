@@ -1,15 +1,11 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
-#include <juce_dsp/juce_dsp.h>
-
-#if HAS_PROJECT_DATA
-#include "ProjectData.h"
-#endif
-
-#if BEATCONNECT_ACTIVATION_ENABLED
-#include <beatconnect/Activation.h>
-#endif
+#include "DriveEngine.h"
+#include "PresetLibrary.h"
+#include "SharedResources.h"
+#include "LicenseService.h"
+#include "TraceRecorder.h"
 
 class DriveAudioProcessor : public juce::AudioProcessor
 {
@@ -21,6 +17,13 @@ public:
     void releaseResources() override;
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlockBypassed(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    /** The host's bypass switch drives the bypass parameter (soft, latency-matched bypass). */
+    juce::AudioProcessorParameter* getBypassParameter() const override
+    {
+        return apvts.getParameter(ParameterIDs::bypass);
+    }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -31,10 +34,12 @@ public:
     bool isMidiEffect() const override { return false; }
     double getTailLengthSeconds() const override { return 0.0; }
 
-    int getNumPrograms() override { return 1; }
-    int getCurrentProgram() override { return 0; }
-    void setCurrentProgram(int) override {}
-    const juce::String getProgramName(int) override { return {}; }
+    // Programs are the built-in factory presets: known at construction and
+    // never renumbered by a preset folder rescan
+    int getNumPrograms() override { return juce::jmax(1, presetLibrary->getNumBuiltInPresets()); }
+    int getCurrentProgram() override;
+    void setCurrentProgram(int index) override;
+    const juce::String getProgramName(int index) override;
     void changeProgramName(int, const juce::String&) override {}
 
     void getStateInformation(juce::MemoryBlock& destData) override;
@@ -42,86 +47,131 @@ public:
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
+    // Internal processing chunk size. Takes effect on the next prepareToPlay
+    static constexpr int kDefaultInternalBlockSize = DriveEngine::kDefaultInternalBlockSize;
+    static constexpr int kMinInternalBlockSize = DriveEngine::kMinInternalBlockSize;
+    static constexpr int kMaxInternalBlockSize = DriveEngine::kMaxInternalBlockSize;
+    void setInternalBlockSize(int newSize);
+    int getInternalBlockSize() const { return internalBlockSize; }
+
+    /** The DSP core, for tools that want to look past the plugin wrapper. */
+    DriveEngine& getEngine() { return engine; }
+
+    // Presets
+    PresetLibrary& getPresetLibrary() { return *presetLibrary; }
+    /** Loads a preset by its library key (see PresetLibrary). */
+    bool loadPreset(const juce::String& key);
+    juce::String getCurrentPresetKey() const;
+    void saveUserPreset(const juce::String& name, const juce::String& tags, std::function<void(bool)> callback);
+
     // Visualizer data access
-    float getCurrentRMS() const { return currentRMS.load(); }
-    float getCurrentPeak() const { return currentPeak.load(); }
-    float getEnvelopeFollower() const { return envelopeFollower.load(); }
+    float getCurrentRMS() const { return engine.getInputRMS(); }
+    float getCurrentPeak() const { return engine.getInputPeak(); }
+    float getCurrentTruePeak() const { return engine.getInputTruePeak(); }
+
+    // Levels after the dry/wet mix (the auto-gain reference point)
+    float getOutputRMS() const { return engine.getOutputRMS(); }
+    float getOutputPeak() const { return engine.getOutputPeak(); }
+    float getOutputTruePeak() const { return engine.getOutputTruePeak(); }
+
+    /** True-peak metering is only worth its cost while a UI shows it. */
+    void setTruePeakMetering(bool shouldMeasure) { engine.setTruePeakMetering(shouldMeasure); }
+    float getEnvelopeFollower() const { return engine.getEnvelopeFollower(); }
     int getCurrentMode() const { return currentMode.load(); }
     bool isBypassed() const { return bypassed.load(); }
 
+    /** Oversampling/ADAA tier the saturation is running at (see QualityGovernor). */
+    DriveEngine::ActiveQuality getActiveQuality() const { return engine.getActiveQuality(); }
+
+    // Sanitizer counters (since load or the last reset)
+    juce::uint32 getSanitizedNonFinite() const { return engine.getSanitizedNonFinite(); }
+    juce::uint32 getSanitizedDenormals() const { return engine.getSanitizedDenormals(); }
+    juce::uint32 getStateResets() const { return engine.getStateResets(); }
+    void resetSanitizerCounters() { engine.resetSanitizerCounters(); }
+
     // BeatConnect integration
     bool hasActivationEnabled() const;
-    juce::String getPluginId() const { return pluginId; }
-    juce::String getApiBaseUrl() const { return apiBaseUrl; }
-    juce::String getSupabaseKey() const { return supabaseKey; }
+    juce::String getPluginId() const { return sharedResources->getProjectConfig().pluginId; }
+    juce::String getApiBaseUrl() const { return sharedResources->getProjectConfig().apiBaseUrl; }
+    juce::String getSupabaseKey() const { return sharedResources->getProjectConfig().supabaseKey; }
+
+    // Process-wide immutable data (project config, web UI files)
+    SharedResources& getSharedResources() { return *sharedResources; }
+
+    // Process-wide license state (activation runs on a background thread)
+    LicenseService& getLicenseService() { return *licenseService; }
+
+    // Approximate memory use: what this instance owns vs what all instances share
+    struct MemoryReport
+    {
+        size_t instanceBytes = 0;
+        size_t sharedBytes = 0;
+        int sharingInstances = 0;
+        size_t savedBytes = 0;  // sharedBytes * (sharingInstances - 1)
+    };
+    MemoryReport getMemoryReport() const;
 
 #if BEATCONNECT_ACTIVATION_ENABLED
-    beatconnect::Activation* getActivation() { return activation.get(); }
+    beatconnect::Activation* getActivation() { return licenseService->getActivation(); }
 #endif
 
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
-    void loadProjectData();
+
+    /** Current parameter values in the engine's form. */
+    DriveEngine::Parameters readParameters() const;
+
+    /** Current parameter values in ParameterIDs::stateOrder. */
+    StateSerializer::Values readStateValues() const;
+
+    /** processBlock() body. Hosts that bypass without the parameter set forceBypass. */
+    void processAudio(juce::AudioBuffer<float>& buffer, bool forceBypass);
+
+    /**
+     * Preset and state loads: publishes the whole new parameter set to the
+     * audio thread as one snapshot, then updates the parameter objects
+     * (which notifies the host and the UI).
+     *
+     * Hosts may call setStateInformation() and setCurrentProgram() from a
+     * thread of their own while the editor loads a preset on the message
+     * thread, so loads are serialised by stateLock rather than marshalled
+     * to one thread: the host expects the state to be in place when its
+     * call returns. Never taken on the audio thread.
+     */
+    void loadState(const StateSerializer::DecodedState& state);
 
     juce::AudioProcessorValueTreeState apvts;
 
-    // DSP components
-    juce::dsp::Oversampling<float> oversampling { 2, 2, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR };
-    juce::dsp::WaveShaper<float> waveshaper;
-    juce::dsp::Compressor<float> compressor;
-    juce::dsp::StateVariableTPTFilter<float> toneFilterLow;
-    juce::dsp::StateVariableTPTFilter<float> toneFilterHigh;
-    juce::dsp::StateVariableTPTFilter<float> sidechainHpFilter;
-    juce::dsp::Gain<float> outputGain;
-
-    // Saturation mode functions
-    static float tubeSaturation(float x);
-    static float tapeSaturation(float x);
-    static float transistorSaturation(float x);
-    void updateSaturationMode(int mode);
-    int lastMode = -1;
-
-    // Smoothed parameters
-    juce::SmoothedValue<float> driveSmoothed;
-    juce::SmoothedValue<float> pressureSmoothed;
-    juce::SmoothedValue<float> toneSmoothed;
-    juce::SmoothedValue<float> mixSmoothed;
-
-    // Persistent envelope followers for transient detection (per channel, max 2)
-    float fastEnvelope[2] = { 0.0f, 0.0f };
-    float slowEnvelope[2] = { 0.0f, 0.0f };
-
-    // Sub harmonic generation
-    juce::dsp::StateVariableTPTFilter<float> subFilter;  // Isolate lows for sub generation
-    float subOscPhase[2] = { 0.0f, 0.0f };  // Phase for sub oscillator
-    float lastSubInput[2] = { 0.0f, 0.0f }; // For zero-crossing detection
-
-    // DC blocker
-    float dcBlockerState[2] = { 0.0f, 0.0f };
-
-    // Auto gain smoothing
-    float autoGainSmoothed = 1.0f;
+    // Shared by all instances in the process (created by the first one)
+    juce::SharedResourcePointer<SharedResources> sharedResources;
+    juce::SharedResourcePointer<TraceRecorder> traceRecorder;  // idle unless DRIVE_TRACE is set
+    juce::SharedResourcePointer<LicenseService> licenseService;  // started lazily, see LicenseService
+
+    // Process-wide preset library (scanned once, shared by all instances)
+    juce::SharedResourcePointer<PresetLibrary> presetLibrary;
+    int currentProgram = 0;         // guarded by stateLock
+    juce::String currentPresetKey;  // guarded by stateLock
+
+    // All of the DSP (see DriveEngine)
+    DriveEngine engine;
+    int internalBlockSize = kDefaultInternalBlockSize;
+
+    // Parameter snapshots from loadState(), triple buffered: the loading
+    // thread fills snapshotSlots[writeSlot] and swaps it into sharedSlot;
+    // processBlock swaps sharedSlot with readSlot when it holds a fresh one.
+    // A published slot isn't written again until it comes back as writeSlot
+    static constexpr int kFreshSnapshot = 4;
+    std::array<DriveEngine::Parameters, 3> snapshotSlots;
+    std::atomic<int> sharedSlot { 1 };
+    juce::CriticalSection stateLock;               // one loadState() at a time (see there)
+    int writeSlot = 0;                             // guarded by stateLock
+    int readSlot = 2;                              // audio thread
+    std::atomic<bool> applyingSnapshot { false };  // parameter objects still catching up
+    bool usingSnapshot = false;                    // audio thread
 
     // Visualizer data (atomic for thread safety)
-    std::atomic<float> currentRMS { 0.0f };
-    std::atomic<float> currentPeak { 0.0f };
-    std::atomic<float> envelopeFollower { 0.0f };
     std::atomic<int> currentMode { 0 };
     std::atomic<bool> bypassed { false };
-    float envelopeCoeff = 0.0f;
-
-    // BeatConnect data
-    juce::String pluginId;
-    juce::String apiBaseUrl;
-    juce::String supabaseKey;
-    juce::var buildFlags;
-
-#if BEATCONNECT_ACTIVATION_ENABLED
-    std::unique_ptr<beatconnect::Activation> activation;
-#endif
-
-    // State version for backwards compatibility
-    static constexpr int kStateVersion = 1;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DriveAudioProcessor)
 };
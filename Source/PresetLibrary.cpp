@@ -0,0 +1,564 @@
+#include "PresetLibrary.h"
+#include "FactoryPresets.h"
+
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+    constexpr juce::uint32 kIndexMagic = 0x49565244; // "DRVI"
+    constexpr int kIndexVersion = 3;  // v2: key instead of path, v3: no session parameters
+
+    struct IndexHeader
+    {
+        juce::uint32 magic;
+        juce::int32 version;
+        juce::int32 numRecords;
+        juce::int32 numValues;
+        juce::int64 fingerprint;
+        juce::int32 stringTableOffset;
+        juce::int32 stringTableSize;
+    };
+
+    // Fixed part of a record, followed by numValues floats
+    struct RecordHeader
+    {
+        juce::int32 nameOffset;
+        juce::int32 tagsOffset;
+        juce::int32 keyOffset;
+        juce::int32 flags;
+    };
+
+    constexpr juce::int32 kFlagFactory = 1;
+
+    size_t recordStride(int numValues)
+    {
+        return sizeof(RecordHeader) + sizeof(float) * static_cast<size_t>(numValues);
+    }
+
+    // 64-bit FNV-1a, used to fingerprint the preset folders
+    struct Fingerprint
+    {
+        juce::uint64 hash = 14695981039346656037ull;
+
+        void add(const void* data, size_t size)
+        {
+            auto* bytes = static_cast<const juce::uint8*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        }
+
+        void add(juce::int64 value) { add(&value, sizeof(value)); }
+        void add(const juce::String& s) { add(s.toRawUTF8(), s.getNumBytesAsUTF8()); }
+    };
+
+    struct BuildEntry
+    {
+        juce::String name;
+        juce::String tags;
+        juce::String key;
+        bool isFactory = false;
+        StateSerializer::Values values;
+    };
+
+    juce::String builtInKey(const char* name)
+    {
+        return juce::String("factory:") + name;
+    }
+
+    StateSerializer::Values emptyValues()
+    {
+        StateSerializer::Values values;
+        values.fill(std::numeric_limits<float>::quiet_NaN());
+        return values;
+    }
+
+    juce::Array<juce::File> findPresetFiles(const juce::File& folder)
+    {
+        juce::Array<juce::File> files;
+        if (folder.isDirectory())
+        {
+            for (const auto& entry : juce::RangedDirectoryIterator(folder, true,
+                     juce::String("*") + PresetLibrary::presetFileExtension, juce::File::findFiles))
+                files.add(entry.getFile());
+        }
+        files.sort();
+        return files;
+    }
+
+    bool parsePresetFile(const juce::File& file, BuildEntry& entry)
+    {
+        auto json = juce::JSON::parse(file);
+        if (!json.isObject())
+            return false;
+
+        entry.name = json.getProperty("name", file.getFileNameWithoutExtension()).toString();
+        entry.key = file.getFullPathName();
+        entry.values = emptyValues();
+
+        auto tags = json.getProperty("tags", juce::var());
+        if (auto* tagArray = tags.getArray())
+        {
+            juce::StringArray tagStrings;
+            for (const auto& t : *tagArray)
+                tagStrings.add(t.toString());
+            entry.tags = tagStrings.joinIntoString(" ");
+        }
+        else
+        {
+            entry.tags = tags.toString();
+        }
+
+        // Session settings in older files are ignored (left NaN)
+        auto params = json.getProperty("parameters", juce::var());
+        for (int i = 0; i < ParameterIDs::numStateParameters; ++i)
+        {
+            if (!ParameterIDs::isPresetParameter(ParameterIDs::stateOrder[i]))
+                continue;
+
+            auto value = params.getProperty(ParameterIDs::stateOrder[i], juce::var());
+            if (!value.isVoid())
+                entry.values[static_cast<size_t>(i)] = static_cast<float>(value);
+        }
+
+        return true;
+    }
+
+    void addBuiltInPresets(std::vector<BuildEntry>& entries)
+    {
+        for (const auto& p : FactoryPresets::presets)
+        {
+            BuildEntry e;
+            e.name = p.name;
+            e.tags = p.tags;
+            e.key = builtInKey(p.name);
+            e.isFactory = true;
+            e.values = emptyValues();
+
+            auto set = [&e](const char* id, float value) {
+                for (int i = 0; i < ParameterIDs::numStateParameters; ++i)
+                    if (juce::String(ParameterIDs::stateOrder[i]) == id)
+                        e.values[static_cast<size_t>(i)] = value;
+            };
+
+            set(ParameterIDs::drive, p.drive);
+            set(ParameterIDs::pressure, p.pressure);
+            set(ParameterIDs::tone, p.tone);
+            set(ParameterIDs::mix, p.mix);
+            set(ParameterIDs::output, p.output);
+            set(ParameterIDs::mode, static_cast<float>(p.mode));
+            set(ParameterIDs::attack, p.attack);
+            set(ParameterIDs::sustain, p.sustain);
+            set(ParameterIDs::autoGain, p.autoGain ? 1.0f : 0.0f);
+
+            entries.push_back(std::move(e));
+        }
+    }
+
+    juce::File indexFileFor(juce::int64 fingerprint)
+    {
+        return PresetLibrary::getIndexFolder()
+            .getChildFile("PresetIndex-" + juce::String::toHexString(fingerprint) + ".bin");
+    }
+
+    bool writeIndex(const juce::File& file, std::vector<BuildEntry>& entries, juce::int64 fingerprint)
+    {
+        std::stable_sort(entries.begin(), entries.end(), [](const BuildEntry& a, const BuildEntry& b) {
+            if (a.isFactory != b.isFactory)
+                return a.isFactory;
+            return a.name.compareNatural(b.name) < 0;
+        });
+
+        // String table
+        juce::MemoryOutputStream strings;
+        auto addString = [&strings](const juce::String& s) {
+            const auto offset = static_cast<juce::int32>(strings.getPosition());
+            strings.write(s.toRawUTF8(), s.getNumBytesAsUTF8() + 1);
+            return offset;
+        };
+
+        juce::MemoryOutputStream records;
+        for (const auto& e : entries)
+        {
+            RecordHeader r;
+            r.nameOffset = addString(e.name);
+            r.tagsOffset = addString(e.tags);
+            r.keyOffset = addString(e.key);
+            r.flags = e.isFactory ? kFlagFactory : 0;
+            records.write(&r, sizeof(r));
+            records.write(e.values.data(), sizeof(float) * e.values.size());
+        }
+
+        IndexHeader h;
+        h.magic = kIndexMagic;
+        h.version = kIndexVersion;
+        h.numRecords = static_cast<juce::int32>(entries.size());
+        h.numValues = ParameterIDs::numStateParameters;
+        h.fingerprint = fingerprint;
+        h.stringTableOffset = static_cast<juce::int32>(sizeof(IndexHeader) + records.getDataSize());
+        h.stringTableSize = static_cast<juce::int32>(strings.getDataSize());
+
+        juce::TemporaryFile temp(file);
+        {
+            juce::FileOutputStream out(temp.getFile());
+            if (!out.openedOk())
+                return false;
+
+            out.write(&h, sizeof(h));
+            out << records.getMemoryBlock();
+            out << strings.getMemoryBlock();
+            out.flush();
+
+            if (out.getStatus().failed())
+                return false;
+        }
+
+        return temp.overwriteTargetFileWithTemporary();
+    }
+}
+
+//==============================================================================
+class PresetLibrary::Index
+{
+public:
+    explicit Index(const juce::File& file)
+        : mapped(file, juce::MemoryMappedFile::readOnly, false)
+    {
+        const auto size = mapped.getSize();
+        if (mapped.getData() == nullptr || size < sizeof(IndexHeader))
+            return;
+
+        header = static_cast<const IndexHeader*>(mapped.getData());
+
+        const auto recordsEnd = sizeof(IndexHeader) + recordStride(header->numValues) * static_cast<size_t>(header->numRecords);
+        const bool valid = header->magic == kIndexMagic
+                        && header->version == kIndexVersion
+                        && header->numValues == ParameterIDs::numStateParameters
+                        && header->numRecords >= 0
+                        && static_cast<size_t>(header->stringTableOffset) == recordsEnd
+                        && recordsEnd + static_cast<size_t>(header->stringTableSize) <= size;
+
+        if (!valid)
+        {
+            header = nullptr;
+            return;
+        }
+
+        // Key -> record, pointing into the mapped string table
+        byKey.reserve(static_cast<size_t>(header->numRecords));
+        for (int i = 0; i < header->numRecords; ++i)
+            byKey.emplace(string(record(i).keyOffset), i);
+    }
+
+    bool isValid() const { return header != nullptr; }
+    juce::int64 getFingerprint() const { return header->fingerprint; }
+    int size() const { return header != nullptr ? header->numRecords : 0; }
+
+    const RecordHeader& record(int i) const
+    {
+        auto* base = static_cast<const char*>(mapped.getData()) + sizeof(IndexHeader);
+        return *reinterpret_cast<const RecordHeader*>(base + recordStride(header->numValues) * static_cast<size_t>(i));
+    }
+
+    const float* values(int i) const
+    {
+        return reinterpret_cast<const float*>(&record(i) + 1);
+    }
+
+    const char* string(juce::int32 offset) const
+    {
+        if (offset < 0 || offset >= header->stringTableSize)
+            return "";
+        return static_cast<const char*>(mapped.getData()) + header->stringTableOffset + offset;
+    }
+
+    int find(const juce::String& key) const
+    {
+        const auto it = byKey.find(std::string_view(key.toRawUTF8()));
+        return it != byKey.end() ? it->second : -1;
+    }
+
+    Entry entry(int i) const
+    {
+        const auto& r = record(i);
+        return { juce::String::fromUTF8(string(r.keyOffset)),
+                 juce::String::fromUTF8(string(r.nameOffset)),
+                 juce::String::fromUTF8(string(r.tagsOffset)),
+                 (r.flags & kFlagFactory) != 0 };
+    }
+
+private:
+    juce::MemoryMappedFile mapped;
+    const IndexHeader* header = nullptr;
+    std::unordered_map<std::string_view, int> byKey;
+};
+
+//==============================================================================
+PresetLibrary::PresetLibrary()
+{
+    // The built-in presets are compiled in, so the host's program list is
+    // complete before it asks. Nothing touches the disk here - the first
+    // scan runs on the worker thread
+    std::vector<BuildEntry> entries;
+    addBuiltInPresets(entries);
+    builtIns.reserve(entries.size());
+    for (auto& e : entries)
+        builtIns.push_back({ e.key, e.name, e.values });
+
+    worker.addJob([this] { scan(); });
+}
+
+PresetLibrary::~PresetLibrary()
+{
+    worker.removeAllJobs(true, 5000);
+}
+
+juce::File PresetLibrary::getFactoryPresetFolder()
+{
+    return juce::File::getSpecialLocation(juce::File::commonApplicationDataDirectory)
+        .getChildFile("BeatConnect").getChildFile("DRIVE").getChildFile("Presets");
+}
+
+juce::File PresetLibrary::getUserPresetFolder()
+{
+    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+        .getChildFile("BeatConnect").getChildFile("DRIVE").getChildFile("Presets");
+}
+
+juce::File PresetLibrary::getIndexFolder()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("BeatConnect").getChildFile("DRIVE").getChildFile("Cache");
+}
+
+std::shared_ptr<const PresetLibrary::Index> PresetLibrary::getIndex() const
+{
+    const juce::SpinLock::ScopedLockType lock(indexLock);
+    return currentIndex;
+}
+
+int PresetLibrary::getNumPresets() const
+{
+    auto index = getIndex();
+    return index != nullptr ? index->size() : 0;
+}
+
+juce::String PresetLibrary::getBuiltInPresetKey(int index) const
+{
+    return juce::isPositiveAndBelow(index, getNumBuiltInPresets()) ? builtIns[static_cast<size_t>(index)].key
+                                                                   : juce::String();
+}
+
+juce::String PresetLibrary::getBuiltInPresetName(int index) const
+{
+    return juce::isPositiveAndBelow(index, getNumBuiltInPresets()) ? builtIns[static_cast<size_t>(index)].name
+                                                                   : juce::String();
+}
+
+int PresetLibrary::findBuiltInPreset(const juce::String& key) const
+{
+    for (size_t i = 0; i < builtIns.size(); ++i)
+        if (builtIns[i].key == key)
+            return static_cast<int>(i);
+    return -1;
+}
+
+juce::String PresetLibrary::getPresetName(const juce::String& key) const
+{
+    if (const int builtIn = findBuiltInPreset(key); builtIn >= 0)
+        return builtIns[static_cast<size_t>(builtIn)].name;
+
+    auto idx = getIndex();
+    const int position = idx != nullptr ? idx->find(key) : -1;
+    if (position < 0)
+        return {};
+    return juce::String::fromUTF8(idx->string(idx->record(position).nameOffset));
+}
+
+bool PresetLibrary::getPresetValues(const juce::String& key, StateSerializer::DecodedState& state) const
+{
+    const float* values = nullptr;
+    auto idx = getIndex();  // keeps the mapping alive while values are read
+
+    if (const int builtIn = findBuiltInPreset(key); builtIn >= 0)
+    {
+        values = builtIns[static_cast<size_t>(builtIn)].values.data();
+    }
+    else
+    {
+        const int position = idx != nullptr ? idx->find(key) : -1;
+        if (position < 0)
+            return false;
+        values = idx->values(position);
+    }
+
+    for (size_t i = 0; i < state.values.size(); ++i)
+        if (!std::isnan(values[i]))
+            state.values[i] = values[i];
+
+    return true;
+}
+
+juce::String PresetLibrary::getAdjacentPresetKey(const juce::String& key, int delta) const
+{
+    auto idx = getIndex();
+    if (idx == nullptr || idx->size() == 0)
+    {
+        // No scan yet: step through the built-in presets
+        const int count = getNumBuiltInPresets();
+        if (count == 0)
+            return {};
+        const int position = juce::jmax(0, findBuiltInPreset(key));
+        return builtIns[static_cast<size_t>(((position + delta) % count + count) % count)].key;
+    }
+
+    const int count = idx->size();
+    const int position = idx->find(key);
+    const int next = position < 0 ? 0 : ((position + delta) % count + count) % count;
+    return juce::String::fromUTF8(idx->string(idx->record(next).keyOffset));
+}
+
+void PresetLibrary::scan()
+{
+    const auto factoryFiles = findPresetFiles(getFactoryPresetFolder());
+    const auto userFiles = findPresetFiles(getUserPresetFolder());
+
+    Fingerprint fp;
+    fp.add(static_cast<juce::int64>(kIndexVersion));
+    fp.add(static_cast<juce::int64>(ParameterIDs::numStateParameters));
+    fp.add(static_cast<juce::int64>(std::size(FactoryPresets::presets)));
+    for (const auto* files : { &factoryFiles, &userFiles })
+    {
+        for (const auto& f : *files)
+        {
+            fp.add(f.getFullPathName());
+            fp.add(f.getSize());
+            fp.add(f.getLastModificationTime().toMilliseconds());
+        }
+    }
+    const auto fingerprint = static_cast<juce::int64>(fp.hash);
+
+    if (auto existing = getIndex(); existing != nullptr && existing->getFingerprint() == fingerprint)
+        return;
+
+    const auto indexFile = indexFileFor(fingerprint);
+    auto index = std::make_shared<Index>(indexFile);
+
+    if (!index->isValid() || index->getFingerprint() != fingerprint)
+    {
+        std::vector<BuildEntry> entries;
+        entries.reserve(std::size(FactoryPresets::presets) + static_cast<size_t>(factoryFiles.size() + userFiles.size()));
+        addBuiltInPresets(entries);
+
+        for (const auto* files : { &factoryFiles, &userFiles })
+        {
+            for (const auto& f : *files)
+            {
+                BuildEntry e;
+                if (parsePresetFile(f, e))
+                {
+                    e.isFactory = (files == &factoryFiles);
+                    entries.push_back(std::move(e));
+                }
+            }
+        }
+
+        indexFile.getParentDirectory().createDirectory();
+        index.reset();
+        if (!writeIndex(indexFile, entries, fingerprint))
+        {
+            DBG("Failed to write preset index: " + indexFile.getFullPathName());
+            return;
+        }
+
+        index = std::make_shared<Index>(indexFile);
+        if (!index->isValid())
+            return;
+    }
+
+    {
+        const juce::SpinLock::ScopedLockType lock(indexLock);
+        currentIndex = std::move(index);
+    }
+
+    // Stale index files may still be mapped by another process - ignore failures
+    for (const auto& entry : juce::RangedDirectoryIterator(getIndexFolder(), false, "PresetIndex-*.bin"))
+        if (entry.getFile() != indexFile)
+            entry.getFile().deleteFile();
+
+    sendChangeMessage();
+}
+
+void PresetLibrary::rescanAsync()
+{
+    worker.addJob([this] { scan(); });
+}
+
+void PresetLibrary::queryAsync(const juce::String& searchText, int offset, int limit,
+                               std::function<void(QueryResult)> callback)
+{
+    worker.addJob([this, searchText, offset, limit, callback = std::move(callback)]
+    {
+        QueryResult result;
+
+        if (auto index = getIndex())
+        {
+            for (int i = 0; i < index->size(); ++i)
+            {
+                const auto& r = index->record(i);
+                const bool matches = searchText.isEmpty()
+                    || juce::String::fromUTF8(index->string(r.nameOffset)).containsIgnoreCase(searchText)
+                    || juce::String::fromUTF8(index->string(r.tagsOffset)).containsIgnoreCase(searchText);
+
+                if (!matches)
+                    continue;
+
+                if (result.totalMatches >= offset && result.entries.size() < limit)
+                    result.entries.add(index->entry(i));
+
+                ++result.totalMatches;
+            }
+        }
+
+        juce::MessageManager::callAsync([callback, result = std::move(result)]() mutable {
+            callback(std::move(result));
+        });
+    });
+}
+
+void PresetLibrary::saveUserPresetAsync(const juce::String& name, const juce::String& tags,
+                                        const StateSerializer::Values& values,
+                                        std::function<void(bool)> callback)
+{
+    worker.addJob([this, name, tags, values, callback = std::move(callback)]
+    {
+        juce::DynamicObject::Ptr params = new juce::DynamicObject();
+        for (int i = 0; i < ParameterIDs::numStateParameters; ++i)
+            if (ParameterIDs::isPresetParameter(ParameterIDs::stateOrder[i]))
+                params->setProperty(ParameterIDs::stateOrder[i], values[static_cast<size_t>(i)]);
+
+        juce::Array<juce::var> tagArray;
+        for (const auto& t : juce::StringArray::fromTokens(tags, " ,", ""))
+            tagArray.add(t);
+
+        juce::DynamicObject::Ptr preset = new juce::DynamicObject();
+        preset->setProperty("name", name);
+        preset->setProperty("tags", tagArray);
+        preset->setProperty("parameters", juce::var(params.get()));
+
+        auto folder = getUserPresetFolder();
+        folder.createDirectory();
+        auto file = folder.getChildFile(juce::File::createLegalFileName(name) + presetFileExtension);
+        const bool ok = file.replaceWithText(juce::JSON::toString(juce::var(preset.get())));
+
+        if (ok)
+            scan();
+
+        if (callback)
+            juce::MessageManager::callAsync([callback, ok] { callback(ok); });
+    });
+}
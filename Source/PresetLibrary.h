@@ -0,0 +1,125 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include "StateSerializer.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * Indexed on-disk preset library.
+ *
+ * The factory and user preset folders are scanned once on a background thread
+ * into a compact index file (fixed-size records + string table) which is then
+ * memory-mapped. The index is only rebuilt when the folder contents change.
+ *
+ * Every preset has a stable key: "factory:<name>" for the built-in presets,
+ * the full file path for preset files. Positions in the index change when a
+ * rescan re-sorts it, so presets are loaded and remembered by key. The
+ * built-in presets are set up synchronously in the constructor (no disk
+ * access) and back the host's program list, so the program count and
+ * numbering are fixed from construction on.
+ *
+ * Shared by all plugin instances in the process (juce::SharedResourcePointer),
+ * so a session with many instances scans and maps the library only once.
+ * Queries run on the library's worker thread and report back on the message
+ * thread, so browsing never blocks the UI. A change message is broadcast
+ * whenever a new index has been mapped.
+ *
+ * Preset file format (*.drvpreset, JSON):
+ *   { "name": "Fat Kick", "tags": ["kick", "tube"], "parameters": { "drive": 40, ... } }
+ */
+class PresetLibrary : public juce::ChangeBroadcaster
+{
+public:
+    PresetLibrary();
+    ~PresetLibrary() override;
+
+    struct Entry
+    {
+        juce::String key;
+        juce::String name;
+        juce::String tags;
+        bool isFactory = false;
+    };
+
+    struct QueryResult
+    {
+        int totalMatches = 0;
+        juce::Array<Entry> entries;
+    };
+
+    /** Number of presets in the current index (0 until the first scan finished). */
+    int getNumPresets() const;
+
+    /** True once the first scan has been mapped. */
+    bool isReady() const { return getNumPresets() > 0; }
+
+    // Built-in factory presets, available from construction (host programs)
+    int getNumBuiltInPresets() const { return static_cast<int>(builtIns.size()); }
+    juce::String getBuiltInPresetKey(int index) const;
+    juce::String getBuiltInPresetName(int index) const;
+
+    /** Position of a built-in preset's key, or -1. */
+    int findBuiltInPreset(const juce::String& key) const;
+
+    /** Name of a preset. Reads from the mapped index, safe on the message thread. */
+    juce::String getPresetName(const juce::String& key) const;
+
+    /**
+     * Copies a preset's values into a decoded state. Parameters the preset
+     * does not define, and the session parameters (ParameterIDs), are left
+     * untouched: callers pre-fill the current values.
+     */
+    bool getPresetValues(const juce::String& key, StateSerializer::DecodedState& state) const;
+
+    /**
+     * The preset delta places away from key in the full, sorted library,
+     * wrapping around. The first preset if key isn't in it.
+     */
+    juce::String getAdjacentPresetKey(const juce::String& key, int delta) const;
+
+    /**
+     * Filters presets by a case-insensitive substring of name or tags.
+     * The callback is invoked on the message thread.
+     */
+    void queryAsync(const juce::String& searchText, int offset, int limit,
+                    std::function<void(QueryResult)> callback);
+
+    /** Writes a user preset and rescans in the background. */
+    void saveUserPresetAsync(const juce::String& name, const juce::String& tags,
+                             const StateSerializer::Values& values,
+                             std::function<void(bool)> callback);
+
+    /** Forces a rescan (e.g. after presets were copied into the folders). */
+    void rescanAsync();
+
+    static juce::File getFactoryPresetFolder();
+    static juce::File getUserPresetFolder();
+    static juce::File getIndexFolder();
+
+    static constexpr const char* presetFileExtension = ".drvpreset";
+
+private:
+    class Index;
+    struct BuiltIn
+    {
+        juce::String key;
+        juce::String name;
+        StateSerializer::Values values;
+    };
+
+    void scan();
+    std::shared_ptr<const Index> getIndex() const;
+
+    std::vector<BuiltIn> builtIns;  // immutable after construction
+
+    mutable juce::SpinLock indexLock;
+    std::shared_ptr<const Index> currentIndex;
+
+    juce::ThreadPool worker { 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetLibrary)
+};
@@ -0,0 +1,129 @@
+#include "QualityGovernor.h"
+#include "ChannelStrip.h"
+
+void QualityGovernor::prepare(double newSampleRate, int maximumBlockSize)
+{
+    static_assert(kNumTiers == ChannelStrip::kOversamplingStages + 1, "one baseline per oversampling factor");
+
+    sampleRate = newSampleRate;
+    loadMeasurer.reset(sampleRate, maximumBlockSize);
+
+    // Internal rate of the top factor stays at or below ~192k
+    if (sampleRate >= 176400.0)
+        rateCapStages = 0;
+    else if (sampleRate >= 88200.0)
+        rateCapStages = 1;
+    else
+        rateCapStages = ChannelStrip::kOversamplingStages;
+
+    reset();
+}
+
+void QualityGovernor::reset()
+{
+    stepsDown = 0;
+    stepUpSeconds = kStepUpSeconds;
+    probingUp = false;
+    startSettling();
+
+    for (auto& baseline : baselines)
+        baseline = {};
+}
+
+void QualityGovernor::Baseline::add(double load, double seconds)
+{
+    if (windowSeconds == 0.0 || load < current)
+        current = load;
+
+    windowSeconds += seconds;
+
+    if (windowSeconds >= kBaselineWindowSeconds)
+    {
+        // Start a new window, so a lasting change in cost (other settings,
+        // a different host block size) becomes the baseline within two
+        previous = current;
+        windowSeconds = 0.0;
+    }
+}
+
+double QualityGovernor::Baseline::get() const
+{
+    return previous > 0.0 ? juce::jmin(current, previous) : current;
+}
+
+void QualityGovernor::startSettling()
+{
+    settleSeconds = kSettleSeconds;
+    settleBlocks = kSettleBlocks;
+    secondsOver = 0.0;
+    secondsUnder = 0.0;
+}
+
+int QualityGovernor::getTopStages(int requestedStages) const
+{
+    return juce::jmin(requestedStages, rateCapStages);
+}
+
+void QualityGovernor::update(int requestedStages, bool adaptive, int numSamples)
+{
+    if (!adaptive)
+    {
+        reset();
+        return;
+    }
+
+    const int maxStepsDown = getTopStages(requestedStages);
+    stepsDown = juce::jmin(stepsDown, maxStepsDown);
+
+    const double load = loadMeasurer.getLoadAsProportion();
+    const double blockSeconds = numSamples / sampleRate;
+
+    // The measured load is smoothed over blocks, so it lags a tier change
+    // (and starts from zero): ignore it until it has caught up
+    if (settleSeconds > 0.0 || settleBlocks > 0)
+    {
+        settleSeconds -= blockSeconds;
+        --settleBlocks;
+        return;
+    }
+
+    // How much slower than its own steady state the instance runs at this tier
+    auto& baseline = baselines[maxStepsDown - stepsDown];
+    baseline.add(load, blockSeconds);
+    const double steady = baseline.get();
+    const double pressure = steady > 0.0 ? load / steady : 1.0;
+
+    const bool over = pressure > kStepDownPressure || load > kStepDownLoad;
+    const bool under = pressure < kStepUpPressure && load < kStepUpLoad;
+    secondsOver = over ? secondsOver + blockSeconds : 0.0;
+    secondsUnder = under ? secondsUnder + blockSeconds : 0.0;
+
+    if (secondsOver >= kStepDownSeconds && stepsDown < maxStepsDown)
+    {
+        // Undoing a step up: wait longer before the next one
+        if (probingUp)
+            stepUpSeconds = juce::jmin(stepUpSeconds * 2.0, kMaxStepUpSeconds);
+
+        ++stepsDown;
+        probingUp = false;
+        startSettling();
+    }
+    else if (secondsUnder >= stepUpSeconds && stepsDown > 0)
+    {
+        --stepsDown;
+        probingUp = true;
+        startSettling();
+    }
+}
+
+QualityGovernor::Tier QualityGovernor::getTier(int requestedStages, bool requestedAdaa, bool adaptive) const
+{
+    if (!adaptive)
+        return { requestedStages, requestedAdaa };
+
+    // Stepped-down tiers trade the factor for ADAA, which keeps the
+    // aliasing of the lower factors down. What a step saves per mode is in
+    // DriveAliasingAnalyzer's tier table (ns/sample relative to 4x)
+    const int stages = juce::jmax(0, getTopStages(requestedStages) - stepsDown);
+    return { stages, requestedAdaa || stepsDown > 0 };
+}
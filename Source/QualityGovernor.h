@@ -0,0 +1,105 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+/**
+ * Adaptive quality: picks the saturation's oversampling factor and ADAA from
+ * the user's setting, the base sample rate and the instance's measured load.
+ *
+ * With adaptive quality on, the top factor is capped by the base rate (2x at
+ * 88.2/96k, 1x at 176.4/192k, where 4x only adds cost), and the governor
+ * steps down one factor at a time while the instance is under pressure,
+ * switching ADAA on so the lower factors don't alias. It steps back up once
+ * the pressure has been low for a while.
+ *
+ * Load is the share of each block's real-time duration spent in the engine
+ * (juce::AudioProcessLoadMeasurer). In a large session a single instance
+ * only ever uses a small share, so the load alone says little. Pressure is
+ * the load relative to the instance's own steady-state load at the current
+ * tier, a rolling minimum over the last 30-60 seconds: an overloaded
+ * machine (threads preempted, caches thrashed, clocks throttled) makes
+ * every instance run slower than it does on its own, and they all step
+ * down together. A load over kStepDownLoad on its own (one heavy instance
+ * on a slow machine) steps down as well.
+ *
+ * The load is smoothed over blocks, so after every tier change (and after
+ * reset()) it is ignored for a second and at least kSettleBlocks blocks.
+ *
+ * Stepping down relieves the machine, so pressure drops and the step back
+ * up would bring it back. A step down that undoes a step up doubles the
+ * hold before the next step up (5 s up to 80 s), so a session that only
+ * fits at the lower tier stops probing the higher one. Offline renders
+ * always run at the user's setting.
+ *
+ * Audio thread only.
+ */
+class QualityGovernor
+{
+public:
+    struct Tier
+    {
+        int oversamplingStages = 0;  // 0 = 1x, 1 = 2x, 2 = 4x
+        bool adaa = false;
+    };
+
+    void prepare(double sampleRate, int maximumBlockSize);
+
+    /** Back to the top tier. */
+    void reset();
+
+    /** Times the engine's blocks (wrap process() in a ScopedTimer on it). */
+    juce::AudioProcessLoadMeasurer& getLoadMeasurer() { return loadMeasurer; }
+
+    /**
+     * Call once per block before processing it. Moves one step down or up
+     * once the load has been over or under budget for long enough.
+     */
+    void update(int requestedStages, bool adaptive, int numSamples);
+
+    /** The tier to run for the user's settings. */
+    Tier getTier(int requestedStages, bool requestedAdaa, bool adaptive) const;
+
+private:
+    /** Highest factor worth running at the base rate. */
+    int getTopStages(int requestedStages) const;
+
+    /** Ignores the load until the smoothed measurement has caught up. */
+    void startSettling();
+
+    /** Rolling minimum: the lower of the current and the previous window's minimum. */
+    struct Baseline
+    {
+        double current = 0.0;
+        double previous = 0.0;
+        double windowSeconds = 0.0;
+
+        void add(double load, double seconds);
+        double get() const;
+    };
+
+    // Load relative to the baseline (pressure), share of the block's
+    // real-time duration (load), and how long they have to hold
+    static constexpr double kStepDownPressure = 1.5;
+    static constexpr double kStepUpPressure = 1.15;
+    static constexpr double kStepDownLoad = 0.25;
+    static constexpr double kStepUpLoad = 0.10;
+    static constexpr double kStepDownSeconds = 0.5;
+    static constexpr double kStepUpSeconds = 5.0;
+    static constexpr double kMaxStepUpSeconds = 80.0;
+    static constexpr double kBaselineWindowSeconds = 30.0;
+    static constexpr double kSettleSeconds = 1.0;
+    static constexpr int kSettleBlocks = 32;
+    static constexpr int kNumTiers = 3;  // 1x, 2x, 4x
+
+    juce::AudioProcessLoadMeasurer loadMeasurer;
+    double sampleRate = 44100.0;
+    int rateCapStages = 2;
+    int stepsDown = 0;
+    double secondsOver = 0.0;
+    double secondsUnder = 0.0;
+    double stepUpSeconds = kStepUpSeconds;
+    bool probingUp = false;     // the last step was up
+    double settleSeconds = 0.0;
+    int settleBlocks = 0;
+    Baseline baselines[kNumTiers];  // per oversampling stages
+};
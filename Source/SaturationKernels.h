@@ -0,0 +1,148 @@
+#pragma once
+
+#include <math.h>
+
+// Kernel code is compiled once per ISA level (see KernelDispatch). Each
+// translation unit defines DRIVE_KERNEL_ISA before including this header so
+// its copies of the inline functions get distinct symbols; otherwise the
+// linker could pick e.g. the AVX2 copy for the baseline path. For the same
+// reason kernels only call the helpers below and plain C libm functions,
+// never inline std:: overloads or templates.
+#ifndef DRIVE_KERNEL_ISA
+ #define DRIVE_KERNEL_ISA generic
+#endif
+
+/**
+ * Per-sample saturation curves for the three modes.
+ *
+ * x is the input after drive gain has been applied; driveNorm (0-1) shapes
+ * the curve itself. Kept inline in a header so the channel strip's loops can
+ * evaluate one or (while crossfading between modes) two of them without a
+ * function pointer call per sample.
+ */
+namespace SaturationKernels
+{
+    enum Mode
+    {
+        tube = 0,
+        tape,
+        transistor,
+        numModes
+    };
+
+inline namespace DRIVE_KERNEL_ISA
+{
+    inline float absValue(float x)                    { return x < 0.0f ? -x : x; }
+    inline float maxValue(float a, float b)           { return a > b ? a : b; }
+    inline float clampValue(float x, float lo, float hi) { return x < lo ? lo : (x > hi ? hi : x); }
+
+    // =================== TUBE ===================
+    // Warm, fat, musical. Even harmonics dominant.
+    // Asymmetric soft clipping, preserves low end punch
+    inline float tubeSample(float x, float driveNorm)
+    {
+        // Asymmetric waveshaping (triode-like)
+        const float bias = 0.1f * driveNorm; // Slight DC bias adds even harmonics
+        const float biased = x + bias;
+        float shaped;
+
+        // Soft clip with different curves for +/-
+        if (biased >= 0.0f)
+        {
+            // Positive: gentle saturation
+            shaped = biased / (1.0f + biased * 0.5f);
+            // Add 2nd harmonic warmth
+            shaped += 0.2f * driveNorm * biased * biased / (1.0f + biased * biased);
+        }
+        else
+        {
+            // Negative: slightly harder clip (tube grid conduction)
+            shaped = biased / (1.0f - biased * 0.7f);
+        }
+
+        // Final soft limit with warmth
+        shaped = tanhf(shaped * 0.8f) * 1.1f;
+
+        // Remove DC from bias
+        shaped -= tanhf(bias * 0.8f) * 0.3f;
+        return shaped;
+    }
+
+    // =================== TAPE ===================
+    // Glue, compression, warmth. Soft knee saturation.
+    // Slight high frequency rolloff, "vintage" character
+    inline float tapeSample(float x, float driveNorm)
+    {
+        // Soft knee compression before saturation
+        float compressed;
+        const float threshold = 0.3f;
+        const float absX = absValue(x);
+        if (absX < threshold)
+        {
+            compressed = x;
+        }
+        else
+        {
+            // Soft knee
+            const float over = absX - threshold;
+            const float ratio = 1.0f + driveNorm * 3.0f;
+            const float reduced = threshold + over / ratio;
+            compressed = (x > 0 ? reduced : -reduced);
+        }
+
+        // Tape saturation (smooth S-curve)
+        float shaped = compressed / (1.0f + absValue(compressed) * 0.4f);
+
+        // Hysteresis-like harmonic generation
+        shaped += 0.15f * driveNorm * sinf(compressed * 2.0f) * expf(-absValue(compressed));
+
+        // Subtle high frequency loss (tape head gap)
+        return shaped * 0.85f + tanhf(shaped * 1.5f) * 0.15f;
+    }
+
+    // =================== SOLID (Transistor) ===================
+    // Aggressive, gritty, harsh. Odd harmonics dominant.
+    // Hard clipping, crossover distortion, "in your face"
+    inline float transistorSample(float x, float driveNorm)
+    {
+        // Hard clipping with transistor character
+        float driven = x * (1.0f + driveNorm * 2.0f);
+
+        // Crossover distortion (transistor dead zone)
+        const float deadZone = 0.05f * (1.0f - driveNorm * 0.5f);
+        if (absValue(driven) < deadZone)
+        {
+            driven *= 0.3f; // Reduced gain in dead zone
+        }
+
+        // Asymmetric hard clipping
+        const float posClip = 0.8f - driveNorm * 0.3f;
+        const float negClip = -0.6f + driveNorm * 0.2f;
+
+        if (driven > posClip)
+            driven = posClip + (driven - posClip) * 0.05f;
+        if (driven < negClip)
+            driven = negClip + (driven - negClip) * 0.03f;
+
+        // Add harsh odd harmonics
+        float shaped = driven + 0.3f * driveNorm * driven * driven * driven;
+
+        // Hard limit
+        shaped = clampValue(shaped, -1.2f, 1.2f);
+
+        // Final harsh character
+        return shaped * 0.7f + tanhf(shaped * 3.0f) * 0.3f;
+    }
+
+    inline float processSample(int mode, float x, float driveNorm)
+    {
+        switch (mode)
+        {
+            case tube:       return tubeSample(x, driveNorm);
+            case tape:       return tapeSample(x, driveNorm);
+            case transistor: return transistorSample(x, driveNorm);
+            default:         return tanhf(x);
+        }
+    }
+} // namespace DRIVE_KERNEL_ISA
+}
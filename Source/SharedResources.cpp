@@ -0,0 +1,130 @@
+#include "SharedResources.h"
+
+#if HAS_PROJECT_DATA
+#include "ProjectData.h"
+#endif
+
+SharedResources::SharedResources()
+{
+    loadProjectConfig();
+}
+
+void SharedResources::loadProjectConfig()
+{
+#if HAS_PROJECT_DATA
+    int dataSize = 0;
+    const char* data = ProjectData::getNamedResource("project_data_json", dataSize);
+
+    if (data == nullptr || dataSize == 0)
+    {
+        DBG("No project_data.json found in binary data");
+        return;
+    }
+
+    auto parsed = juce::JSON::parse(juce::String::fromUTF8(data, dataSize));
+    if (parsed.isVoid())
+    {
+        DBG("Failed to parse project_data.json");
+        return;
+    }
+
+    projectConfig.pluginId = parsed.getProperty("pluginId", "").toString();
+    projectConfig.apiBaseUrl = parsed.getProperty("apiBaseUrl", "").toString();
+    projectConfig.supabaseKey = parsed.getProperty("supabasePublishableKey", "").toString();
+    projectConfig.buildFlags = parsed.getProperty("flags", juce::var());
+    projectConfig.sourceBytes = static_cast<size_t>(dataSize);
+    projectConfig.loaded = true;
+
+    DBG("Loaded project data - pluginId: " + projectConfig.pluginId);
+#endif
+}
+
+juce::File SharedResources::findWebResourcesDirectory()
+{
+    // Handle both Standalone and VST3 paths
+    auto executableFile = juce::File::getSpecialLocation(juce::File::currentExecutableFile);
+    auto executableDir = executableFile.getParentDirectory();
+
+    // Try Standalone path first: executable/../Resources/WebUI
+    auto dir = executableDir.getChildFile("Resources").getChildFile("WebUI");
+
+    // If that doesn't exist, try VST3 path: executable/../../Resources/WebUI
+    if (!dir.isDirectory())
+    {
+        dir = executableDir.getParentDirectory()
+                  .getChildFile("Resources")
+                  .getChildFile("WebUI");
+    }
+
+    DBG("Resources dir: " + dir.getFullPathName());
+    DBG("Resources exist: " + juce::String(dir.isDirectory() ? "yes" : "no"));
+
+    return dir;
+}
+
+juce::File SharedResources::getWebResourcesDirectory() const
+{
+    const juce::ScopedLock sl(webLock);
+
+    if (webResourcesDir == juce::File())
+        webResourcesDir = findWebResourcesDirectory();
+
+    return webResourcesDir;
+}
+
+juce::String SharedResources::getMimeType(const juce::String& path)
+{
+    if (path.endsWith(".html"))  return "text/html";
+    if (path.endsWith(".css"))   return "text/css";
+    if (path.endsWith(".js"))    return "application/javascript";
+    if (path.endsWith(".json"))  return "application/json";
+    if (path.endsWith(".png"))   return "image/png";
+    if (path.endsWith(".svg"))   return "image/svg+xml";
+    if (path.endsWith(".woff2")) return "font/woff2";
+    return "application/octet-stream";
+}
+
+std::shared_ptr<const SharedResources::WebResource> SharedResources::getWebResource(const juce::String& urlPath)
+{
+    // The url is just the path like "/" or "/assets/index.js"
+    auto path = urlPath;
+    if (path.startsWith("/"))
+        path = path.substring(1);
+    if (path.isEmpty())
+        path = "index.html";
+
+    const juce::ScopedLock sl(webLock);
+
+    if (auto it = webCache.find(path); it != webCache.end())
+        return it->second;
+
+    if (webResourcesDir == juce::File())
+        webResourcesDir = findWebResourcesDirectory();
+
+    auto file = webResourcesDir.getChildFile(path);
+
+    // Don't serve anything outside the bundle
+    if (!file.isAChildOf(webResourcesDir) || !file.existsAsFile())
+        return nullptr;
+
+    juce::MemoryBlock data;
+    if (!file.loadFileAsData(data))
+        return nullptr;
+
+    auto resource = std::make_shared<WebResource>();
+    const auto* bytes = static_cast<const std::byte*>(data.getData());
+    resource->data.assign(bytes, bytes + data.getSize());
+    resource->mimeType = getMimeType(path);
+
+    webCacheBytes += resource->data.size();
+    webCache.emplace(path, resource);
+    return resource;
+}
+
+size_t SharedResources::getSharedBytes() const
+{
+    const size_t tableBytes = adaaTables->getSizeInBytes();
+
+    const juce::ScopedLock sl(webLock);
+    return webCacheBytes + projectConfig.sourceBytes + tableBytes;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "AdaaTables.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ * Immutable data shared by every DRIVE instance in the process.
+ *
+ * Held through juce::SharedResourcePointer, so it is created by the first
+ * instance and destroyed with the last one. Everything here is either built
+ * in the constructor and never modified (project config) or only ever added
+ * to under a lock and handed out as shared_ptr<const> (web bundle files).
+ * The ADAA tables belong to the DSP core (SharedAdaaTables) and are only
+ * referenced here so the memory report can count them.
+ */
+class SharedResources
+{
+public:
+    SharedResources();
+
+    /** Parsed project_data.json. */
+    struct ProjectConfig
+    {
+        bool loaded = false;
+        juce::String pluginId;
+        juce::String apiBaseUrl;
+        juce::String supabaseKey;
+        juce::var buildFlags;
+        size_t sourceBytes = 0;
+    };
+
+    const ProjectConfig& getProjectConfig() const { return projectConfig; }
+
+    /** A file of the bundled web UI, loaded from disk once per process. */
+    struct WebResource
+    {
+        std::vector<std::byte> data;
+        juce::String mimeType;
+    };
+
+    /** Looks up a web UI file by URL path ("/" maps to index.html). Returns nullptr if missing. */
+    std::shared_ptr<const WebResource> getWebResource(const juce::String& urlPath);
+
+    /** Located on first use, so creating the first instance touches no files. */
+    juce::File getWebResourcesDirectory() const;
+
+    /** Bytes currently held by the shared caches. */
+    size_t getSharedBytes() const;
+
+private:
+    void loadProjectConfig();
+    static juce::File findWebResourcesDirectory();
+    static juce::String getMimeType(const juce::String& path);
+
+    ProjectConfig projectConfig;
+
+    mutable juce::CriticalSection webLock;
+    mutable juce::File webResourcesDir;   // guarded by webLock, empty until located
+    std::map<juce::String, std::shared_ptr<const WebResource>> webCache;
+    size_t webCacheBytes = 0;
+
+    juce::SharedResourcePointer<SharedAdaaTables> adaaTables;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedResources)
+};
@@ -0,0 +1,68 @@
+#include "SignalSanitizer.h"
+
+#include <cstring>
+
+namespace
+{
+    constexpr juce::uint32 kExponentMask = 0x7f800000u;
+    constexpr juce::uint32 kMantissaMask = 0x007fffffu;
+
+    inline juce::uint32 bitsOf(float x)
+    {
+        juce::uint32 bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return bits;
+    }
+}
+
+namespace SignalSanitizer
+{
+    bool needsSanitizing(const float* data, int numSamples)
+    {
+        juce::uint32 flags = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto bits = bitsOf(data[i]);
+            const auto exponent = bits & kExponentMask;
+            flags |= static_cast<juce::uint32>(exponent == kExponentMask);
+            flags |= static_cast<juce::uint32>(exponent == 0) & static_cast<juce::uint32>((bits & kMantissaMask) != 0);
+        }
+
+        return flags != 0;
+    }
+
+    bool hasNonFinite(const float* data, int numSamples)
+    {
+        juce::uint32 flags = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+            flags |= static_cast<juce::uint32>((bitsOf(data[i]) & kExponentMask) == kExponentMask);
+
+        return flags != 0;
+    }
+
+    Counts sanitize(float* data, int numSamples)
+    {
+        Counts counts;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto bits = bitsOf(data[i]);
+            const auto exponent = bits & kExponentMask;
+
+            if (exponent == kExponentMask)
+            {
+                data[i] = 0.0f;
+                ++counts.nonFinite;
+            }
+            else if (exponent == 0 && (bits & kMantissaMask) != 0)
+            {
+                data[i] = 0.0f;
+                ++counts.denormals;
+            }
+        }
+
+        return counts;
+    }
+}
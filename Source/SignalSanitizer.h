@@ -0,0 +1,29 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+/**
+ * Input/output checks for NaN, Inf and denormal samples.
+ *
+ * needsSanitizing() and hasNonFinite() only look at exponent bits and OR the
+ * results together without branching, so the compiler vectorises them and
+ * the common (clean) case costs a single pass over the block. sanitize() is
+ * the slow path, only run on a channel that failed the check.
+ */
+namespace SignalSanitizer
+{
+    struct Counts
+    {
+        int nonFinite = 0;   // NaN or Inf replaced by 0
+        int denormals = 0;   // denormals flushed to 0
+    };
+
+    /** True if the data contains any NaN, Inf or denormal. */
+    bool needsSanitizing(const float* data, int numSamples);
+
+    /** True if the data contains any NaN or Inf. */
+    bool hasNonFinite(const float* data, int numSamples);
+
+    /** Replaces NaN/Inf and denormals with 0 and reports how many were replaced. */
+    Counts sanitize(float* data, int numSamples);
+}
@@ -0,0 +1,62 @@
+#include "SoftBypass.h"
+
+void SoftBypass::prepare(double sampleRate, int numChannels, int maxDelaySamples, int maxBlockSize)
+{
+    numDelayChannels = juce::jmax(1, numChannels);
+    delayLine.prepare(numDelayChannels, maxDelaySamples);
+    delayed.setSize(1, juce::jmax(1, maxBlockSize));
+    step = 1.0f / static_cast<float>(juce::jmax(1.0, kFadeSeconds * sampleRate));
+    reset();
+}
+
+void SoftBypass::reset()
+{
+    delayLine.reset();
+    mix = bypassed ? 1.0f : 0.0f;
+}
+
+void SoftBypass::setDelay(int delaySamples)
+{
+    delayLine.setDelay(static_cast<float>(delaySamples));
+}
+
+void SoftBypass::process(const float* const* dry, float* const* processed, int numChannels, int numSamples)
+{
+    numChannels = juce::jmin(numChannels, numDelayChannels);
+
+    // Not bypassed: keep the delay line current so a bypass starts in time
+    if (!bypassed && mix <= 0.0f)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            delayLine.write(ch, dry[ch], numSamples);
+        return;
+    }
+
+    const float target = bypassed ? 1.0f : 0.0f;
+    const float startMix = mix;
+    auto* delayedDry = delayed.getWritePointer(0);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        delayLine.process(ch, dry[ch], delayedDry, numSamples);
+
+        auto* out = processed[ch];
+        float chMix = startMix;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            chMix = target > chMix ? juce::jmin(target, chMix + step) : juce::jmax(target, chMix - step);
+            out[i] += (delayedDry[i] - out[i]) * chMix;
+        }
+
+        mix = chMix;
+    }
+}
+
+void SoftBypass::processIdle(float* const* channels, int numChannels, int numSamples)
+{
+    numChannels = juce::jmin(numChannels, numDelayChannels);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        delayLine.process(ch, channels[ch], channels[ch], numSamples);
+}
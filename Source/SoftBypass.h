@@ -0,0 +1,59 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "LatencyDelay.h"
+
+/**
+ * Click-free bypass with constant latency.
+ *
+ * The input is always written into a delay line as long as the plugin's
+ * reported latency, so the bypassed (dry) signal lines up with the processed
+ * one. Switching fades between the two over kFadeSeconds; once fully
+ * bypassed, the delay line is all that has to run (processIdle()).
+ *
+ * Audio thread only.
+ */
+class SoftBypass
+{
+public:
+    static constexpr double kFadeSeconds = 0.005;
+
+    /**
+     * maxDelaySamples is the largest latency setDelay() will be given,
+     * maxBlockSize the longest process() call (processIdle() takes any length).
+     */
+    void prepare(double sampleRate, int numChannels, int maxDelaySamples, int maxBlockSize);
+    void reset();
+
+    /** Delay of the dry path: the engine's reported latency. */
+    void setDelay(int delaySamples);
+
+    /** Fade target. */
+    void setBypassed(bool shouldBeBypassed) { bypassed = shouldBeBypassed; }
+
+    /** Fully bypassed, the processed path is inaudible and needn't run. */
+    bool isIdle() const { return bypassed && mix >= 1.0f; }
+
+    /**
+     * Feeds the dry input to the delay line and, while bypassed or fading,
+     * mixes the delayed dry signal into the processed one in place.
+     */
+    void process(const float* const* dry, float* const* processed, int numChannels, int numSamples);
+
+    /** Fully bypassed: replaces the channels in place by their delayed input. */
+    void processIdle(float* const* channels, int numChannels, int numSamples);
+
+    size_t getBufferBytes() const
+    {
+        return delayLine.getBufferBytes()
+               + static_cast<size_t>(delayed.getNumChannels() * delayed.getNumSamples()) * sizeof(float);
+    }
+
+private:
+    LatencyDelay delayLine;
+    juce::AudioBuffer<float> delayed;  // one channel, maxBlockSize
+    int numDelayChannels = 0;
+    bool bypassed = false;
+    float mix = 0.0f;   // 0 = processed, 1 = dry
+    float step = 1.0f;  // per sample
+};
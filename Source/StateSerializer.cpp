@@ -0,0 +1,207 @@
+#include "StateSerializer.h"
+
+namespace StateSerializer
+{
+namespace
+{
+    constexpr int kHeaderSize = 3 * static_cast<int>(sizeof(juce::uint32));
+
+    // =========================================================================
+    // MIGRATION HOOKS
+    // migrations[N] upgrades a decoded state from version N to N + 1.
+    // Add an entry here whenever kStateVersion is bumped.
+    // =========================================================================
+    using MigrationHook = void (*)(Values&);
+
+    void migrateFromV0(Values&)
+    {
+        // v0 -> v1 only added the "stateVersion" property, values are unchanged
+    }
+
+    void migrateFromV1(Values&)
+    {
+        // v1 -> v2 changed the container from XML to binary, values are unchanged
+    }
+
+    void migrateFromV2(Values&)
+    {
+        // v2 -> v3 appended the true-peak ceiling parameters. They keep their
+        // defaults (ceiling off), so older sessions sound the same
+    }
+
+    void migrateFromV3(Values&)
+    {
+        // v3 -> v4 appended the oversampling/ADAA parameters. Defaults are 4x
+        // without ADAA, the processing every older version used
+    }
+
+    void migrateFromV4(Values&)
+    {
+        // v4 -> v5 appended adaptiveQuality. It defaults to off, so older
+        // sessions keep their fixed oversampling
+    }
+
+    constexpr MigrationHook migrations[] = { migrateFromV0, migrateFromV1, migrateFromV2, migrateFromV3, migrateFromV4 };
+    static_assert(static_cast<int>(std::size(migrations)) == kStateVersion,
+                  "Every state version needs a migration hook to the next one");
+
+    void migrate(DecodedState& state)
+    {
+        if (state.version < kStateVersion)
+            DBG("Migrating state from version " + juce::String(state.version) + " to " + juce::String(kStateVersion));
+
+        for (int v = juce::jmax(0, state.version); v < kStateVersion; ++v)
+            migrations[v](state.values);
+
+        state.version = kStateVersion;
+    }
+
+    bool readBinary(const void* data, int sizeInBytes, DecodedState& result)
+    {
+        juce::MemoryInputStream in(data, static_cast<size_t>(sizeInBytes), false);
+
+        in.readInt(); // magic, already checked
+        const int version = in.readInt();
+        const int numValues = in.readInt();
+
+        // numValues comes from the blob: bound it by the bytes present rather
+        // than multiplying it out, which could overflow
+        if (version < 2 || numValues < 0
+            || numValues > (sizeInBytes - kHeaderSize) / static_cast<int>(sizeof(float)))
+            return false;
+
+        // Newer layouts only ever append, so extra values are ignored and
+        // missing ones keep their defaults
+        const int numToRead = juce::jmin(numValues, ParameterIDs::numStateParameters);
+        for (int i = 0; i < numToRead; ++i)
+        {
+            const float value = in.readFloat();
+            if (std::isfinite(value))
+                result.values[static_cast<size_t>(i)] = value;
+        }
+
+        result.version = version;
+        return true;
+    }
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_processors
+    bool decodeXml(const void* data, int sizeInBytes, DecodedState& result)
+    {
+        std::unique_ptr<juce::XmlElement> xml(juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
+
+        if (xml == nullptr || !xml->hasTagName("Parameters"))
+            return false;
+
+        // Read the PARAM children directly instead of going through
+        // ValueTree::fromXml + replaceState
+        for (auto* child : xml->getChildWithTagNameIterator("PARAM"))
+        {
+            const auto id = child->getStringAttribute("id");
+            for (int i = 0; i < ParameterIDs::numStateParameters; ++i)
+            {
+                if (id == ParameterIDs::stateOrder[i])
+                {
+                    const auto value = static_cast<float>(child->getDoubleAttribute("value", result.values[static_cast<size_t>(i)]));
+                    if (std::isfinite(value))
+                        result.values[static_cast<size_t>(i)] = value;
+                    break;
+                }
+            }
+        }
+
+        result.version = xml->getIntAttribute("stateVersion", 0);
+        return true;
+    }
+#endif
+}
+
+void writeBinary(const Values& values, juce::MemoryBlock& destData)
+{
+    destData.setSize(static_cast<size_t>(kHeaderSize + ParameterIDs::numStateParameters * static_cast<int>(sizeof(float))));
+    juce::MemoryOutputStream out(destData, false);
+
+    out.writeInt(static_cast<int>(kBinaryMagic));
+    out.writeInt(kStateVersion);
+    out.writeInt(ParameterIDs::numStateParameters);
+
+    for (const float value : values)
+        out.writeFloat(value);
+}
+
+bool isBinaryState(const void* data, int sizeInBytes)
+{
+    return data != nullptr
+        && sizeInBytes >= kHeaderSize
+        && juce::ByteOrder::littleEndianInt(data) == kBinaryMagic;
+}
+
+bool decodeBinary(const void* data, int sizeInBytes, DecodedState& result)
+{
+    if (!isBinaryState(data, sizeInBytes) || !readBinary(data, sizeInBytes, result))
+        return false;
+
+    migrate(result);
+    return true;
+}
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_processors
+
+void fillDefaults(juce::AudioProcessorValueTreeState& apvts, Values& values)
+{
+    for (int i = 0; i < ParameterIDs::numStateParameters; ++i)
+    {
+        if (auto* param = apvts.getParameter(ParameterIDs::stateOrder[i]))
+            values[static_cast<size_t>(i)] = param->convertFrom0to1(param->getDefaultValue());
+    }
+}
+
+void writeBinary(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& destData)
+{
+    Values values;
+    for (int i = 0; i < ParameterIDs::numStateParameters; ++i)
+        values[static_cast<size_t>(i)] = apvts.getRawParameterValue(ParameterIDs::stateOrder[i])->load();
+
+    writeBinary(values, destData);
+}
+
+void writeXml(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& destData)
+{
+    auto state = apvts.copyState();
+    state.setProperty("stateVersion", 1, nullptr);
+
+    std::unique_ptr<juce::XmlElement> xml(state.createXml());
+    juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+}
+
+bool decode(juce::AudioProcessorValueTreeState& apvts, const void* data, int sizeInBytes, DecodedState& result)
+{
+    if (data == nullptr || sizeInBytes <= 0)
+        return false;
+
+    fillDefaults(apvts, result.values);
+
+    const bool ok = isBinaryState(data, sizeInBytes)
+        ? readBinary(data, sizeInBytes, result)
+        : decodeXml(data, sizeInBytes, result);
+
+    if (ok)
+        migrate(result);
+
+    return ok;
+}
+
+void apply(juce::AudioProcessorValueTreeState& apvts, const DecodedState& state)
+{
+    for (int i = 0; i < ParameterIDs::numStateParameters; ++i)
+    {
+        if (auto* param = apvts.getParameter(ParameterIDs::stateOrder[i]))
+        {
+            // Only parameters that change notify the host and listeners
+            const float normalised = param->convertTo0to1(state.values[static_cast<size_t>(i)]);
+            if (normalised != param->getValue())
+                param->setValueNotifyingHost(normalised);
+        }
+    }
+}
+#endif
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "ParameterIDs.h"
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_processors
+#include <juce_audio_processors/juce_audio_processors.h>
+#endif
+
+#include <array>
+
+/**
+ * Plugin state (de)serialization.
+ *
+ * Binary layout (all fields little-endian):
+ *
+ *   uint32  magic       kBinaryMagic ("DRVB")
+ *   int32   version     kStateVersion at the time the state was written
+ *   int32   numValues   number of floats that follow
+ *   float   values[]    denormalised parameter values in ParameterIDs::stateOrder
+ *
+ * Loading a session with many instances only has to copy a few dozen bytes per
+ * instance instead of building and parsing an XML document. States written by
+ * older versions (XML via copyXmlToBinary) are still read.
+ *
+ * The value-array functions only need juce_core, so the DSP library
+ * (DriveEngine) uses the same format. The parameter-tree functions are only
+ * built where juce_audio_processors is available.
+ */
+namespace StateSerializer
+{
+    // v0: XML without a version property
+    // v1: XML with "stateVersion"
+    // v2: binary parameter array
+    // v3: added ceilingMode, ceiling
+    // v4: added oversampling, adaa
+    // v5: added adaptiveQuality
+    inline constexpr int kStateVersion = 5;
+    inline constexpr juce::uint32 kBinaryMagic = 0x42565244; // "DRVB"
+
+    using Values = std::array<float, ParameterIDs::numStateParameters>;
+
+    /** Decoded state before it is applied to the parameters. */
+    struct DecodedState
+    {
+        int version = 0;
+        Values values {};
+    };
+
+    /** Writes a value array in the binary format. */
+    void writeBinary(const Values& values, juce::MemoryBlock& destData);
+
+    /** True if the data starts with the binary state header. */
+    bool isBinaryState(const void* data, int sizeInBytes);
+
+    /**
+     * Decodes the binary format only. result.values must already hold the
+     * defaults for anything the state doesn't contain. Runs the migration
+     * hooks; returns false if the data is not a binary DRIVE state.
+     */
+    bool decodeBinary(const void* data, int sizeInBytes, DecodedState& result);
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_processors
+    /** Fills values with each parameter's default. */
+    void fillDefaults(juce::AudioProcessorValueTreeState& apvts, Values& values);
+
+    /** Writes the current parameter values in the binary format. */
+    void writeBinary(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& destData);
+
+    /** Writes the legacy XML format (kept for benchmarks and older hosts' tooling). */
+    void writeXml(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& destData);
+
+    /**
+     * Decodes either format into a value array. Missing parameters are filled
+     * with their defaults and migration hooks are run up to kStateVersion.
+     * Returns false if the data is not a DRIVE state at all.
+     */
+    bool decode(juce::AudioProcessorValueTreeState& apvts, const void* data, int sizeInBytes, DecodedState& result);
+
+    /** Pushes decoded values into the parameters (notifying the host of the ones that change). */
+    void apply(juce::AudioProcessorValueTreeState& apvts, const DecodedState& state);
+#endif
+}
@@ -0,0 +1,147 @@
+#include "TraceRecorder.h"
+
+std::atomic<TraceRecorder*> TraceRecorder::active { nullptr };
+
+TraceRecorder::TraceRecorder()
+    : juce::Thread("DRIVE trace writer")
+{
+    const auto setting = juce::SystemStats::getEnvironmentVariable("DRIVE_TRACE", {}).trim();
+    if (setting.isEmpty() || setting == "0")
+        return;
+
+    const auto file = setting == "1" ? juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("drive-trace.json")
+                                     : juce::File::getCurrentWorkingDirectory().getChildFile(setting);
+    file.deleteFile();
+
+    stream = std::make_unique<juce::FileOutputStream>(file);
+    if (stream->failedToOpen())
+    {
+        DBG("Trace: could not open " + file.getFullPathName());
+        stream.reset();
+        return;
+    }
+
+    slots = std::make_unique<Slot[]>(kCapacity);
+    originTicks = juce::Time::getHighResolutionTicks();
+    microsecondsPerTick = 1.0e6 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+
+    // Chrome's JSON array format; the closing bracket is optional, so the
+    // file stays loadable if the process dies
+    stream->writeText("[\n", false, false, nullptr);
+
+    active.store(this, std::memory_order_release);
+    startThread(juce::Thread::Priority::low);
+
+    DBG("Trace: recording to " + file.getFullPathName());
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    if (stream == nullptr)
+        return;
+
+    active.store(nullptr, std::memory_order_release);
+    stopThread(2000);
+
+    drain();
+    stream->writeText("\n]\n", false, false, nullptr);
+    stream->flush();
+
+    DBG("Trace: " + juce::String(readIndex) + " spans, " + juce::String(getDroppedEvents()) + " dropped");
+}
+
+void TraceRecorder::record(const char* name, const char* category, juce::int64 startTicks, juce::int64 endTicks) noexcept
+{
+    if (auto* recorder = active.load(std::memory_order_acquire))
+        recorder->push(name, category, startTicks, endTicks);
+}
+
+void TraceRecorder::push(const char* name, const char* category, juce::int64 startTicks, juce::int64 endTicks) noexcept
+{
+    const auto index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = slots[static_cast<size_t>(index & (kCapacity - 1))];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.start.store(startTicks, std::memory_order_relaxed);
+    slot.end.store(endTicks, std::memory_order_relaxed);
+    slot.threadId.store(static_cast<juce::uint64>(reinterpret_cast<juce::pointer_sized_uint>(juce::Thread::getCurrentThreadId())),
+                        std::memory_order_relaxed);
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+void TraceRecorder::run()
+{
+    while (!threadShouldExit())
+    {
+        wait(kFlushIntervalMs);
+        drain();
+    }
+}
+
+void TraceRecorder::drain()
+{
+    const auto end = writeIndex.load(std::memory_order_acquire);
+
+    // More than a ring behind: the oldest spans are gone
+    if (end - readIndex > static_cast<juce::uint64>(kCapacity))
+    {
+        dropped.fetch_add(end - kCapacity - readIndex, std::memory_order_relaxed);
+        readIndex = end - kCapacity;
+    }
+
+    while (readIndex < end)
+    {
+        auto& slot = slots[static_cast<size_t>(readIndex & (kCapacity - 1))];
+        const auto expected = 2 * readIndex + 2;
+        const auto before = slot.sequence.load(std::memory_order_acquire);
+
+        // Still being written: pick it up on the next flush
+        if (before < expected)
+            break;
+
+        const char* name = slot.name.load(std::memory_order_relaxed);
+        const char* category = slot.category.load(std::memory_order_relaxed);
+        const auto start = slot.start.load(std::memory_order_relaxed);
+        const auto finish = slot.end.load(std::memory_order_relaxed);
+        const auto threadId = slot.threadId.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto after = slot.sequence.load(std::memory_order_relaxed);
+        ++readIndex;
+
+        // Overwritten by a newer lap before or while it was read
+        if (before != expected || after != expected)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        auto [it, isNew] = threadNumbers.try_emplace(threadId, static_cast<int>(threadNumbers.size()) + 1);
+        const int tid = it->second;
+
+        if (isNew)
+            writeEvent("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + juce::String(tid)
+                       + ",\"args\":{\"name\":\"" + juce::String(category) + " " + juce::String(tid) + "\"}}");
+
+        writeEvent("{\"name\":\"" + juce::String(name) + "\",\"cat\":\"" + juce::String(category)
+                   + "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + juce::String(tid)
+                   + ",\"ts\":" + juce::String(static_cast<double>(start - originTicks) * microsecondsPerTick, 3)
+                   + ",\"dur\":" + juce::String(static_cast<double>(finish - start) * microsecondsPerTick, 3) + "}");
+    }
+
+    stream->flush();
+}
+
+void TraceRecorder::writeEvent(const juce::String& json)
+{
+    if (!firstEvent)
+        stream->writeText(",\n", false, false, nullptr);
+
+    stream->writeText(json, false, false, nullptr);
+    firstEvent = false;
+}
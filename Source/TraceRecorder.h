@@ -0,0 +1,105 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+
+/**
+ * Opt-in span tracing for the audio, worker and message threads, for
+ * correlating DRIVE's cost with host scheduling when chasing dropouts.
+ *
+ * Set DRIVE_TRACE to an output file (or to "1" for drive-trace.json in the
+ * temp folder) before the first instance is created. Spans are written into
+ * a preallocated ring by any thread without locks or allocation; a background
+ * thread drains it every kFlushIntervalMs and appends the events to the file
+ * in Chrome trace event format (chrome://tracing or ui.perfetto.dev). With
+ * tracing off a span costs one relaxed atomic load.
+ *
+ * Held through juce::SharedResourcePointer by each processor and DriveEngine,
+ * so the ring and the writer live as long as any instance does.
+ */
+class TraceRecorder : private juce::Thread
+{
+public:
+    TraceRecorder();
+    ~TraceRecorder() override;
+
+    static bool isEnabled() noexcept { return active.load(std::memory_order_relaxed) != nullptr; }
+
+    /** Records a finished span. name and category must outlive the recorder (string literals). */
+    static void record(const char* name, const char* category, juce::int64 startTicks, juce::int64 endTicks) noexcept;
+
+    /** Times the enclosing scope, see DRIVE_TRACE_SCOPE. */
+    class Scope
+    {
+    public:
+        Scope(const char* spanName, const char* spanCategory) noexcept
+            : name(spanName), category(spanCategory), enabled(isEnabled()),
+              start(enabled ? juce::Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~Scope()
+        {
+            if (enabled)
+                record(name, category, start, juce::Time::getHighResolutionTicks());
+        }
+
+    private:
+        const char* name;
+        const char* category;
+        const bool enabled;
+        const juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    /** Spans lost because the writer fell more than a ring behind. */
+    juce::uint64 getDroppedEvents() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int kCapacity = 1 << 16; // power of two
+    static constexpr int kFlushIntervalMs = 200;
+
+    // Seqlock slot: sequence is 2n+1 while span n is being written, 2n+2 once
+    // it is complete
+    struct Slot
+    {
+        std::atomic<juce::uint64> sequence { 0 };
+        std::atomic<const char*> name { nullptr };
+        std::atomic<const char*> category { nullptr };
+        std::atomic<juce::int64> start { 0 };
+        std::atomic<juce::int64> end { 0 };
+        std::atomic<juce::uint64> threadId { 0 };
+    };
+
+    void run() override;
+    void push(const char* name, const char* category, juce::int64 startTicks, juce::int64 endTicks) noexcept;
+    void drain();
+    void writeEvent(const juce::String& json);
+
+    static std::atomic<TraceRecorder*> active;
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<juce::uint64> writeIndex { 0 };
+    std::atomic<juce::uint64> dropped { 0 };
+
+    // Writer thread only
+    std::unique_ptr<juce::FileOutputStream> stream;
+    juce::uint64 readIndex = 0;
+    juce::int64 originTicks = 0;
+    double microsecondsPerTick = 0.0;
+    bool firstEvent = true;
+    std::map<juce::uint64, int> threadNumbers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TraceRecorder)
+};
+
+#define DRIVE_TRACE_JOIN_(a, b) a##b
+#define DRIVE_TRACE_JOIN(a, b) DRIVE_TRACE_JOIN_(a, b)
+
+/** Records the enclosing scope as a span, e.g. DRIVE_TRACE_SCOPE("strips", "audio"). */
+#define DRIVE_TRACE_SCOPE(name, category) \
+    TraceRecorder::Scope DRIVE_TRACE_JOIN(driveTraceScope, __LINE__) { name, category }
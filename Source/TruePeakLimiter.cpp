@@ -0,0 +1,247 @@
+#include "TruePeakLimiter.h"
+
+namespace
+{
+    constexpr float kLookaheadSeconds = 0.0015f; // 1.5ms
+    constexpr float kReleaseSeconds = 0.08f;     // 80ms
+    constexpr float kClipKnee = 0.95f;           // soft knee starts at 95% of the ceiling
+
+    // The IIR downsampling filters ring, so the base-rate output can peak a
+    // little above what the oversampled path was held to. Both modes aim
+    // this far under the ceiling; DriveAliasingAnalyzer measures the output
+    // true peak against the ceiling
+    constexpr float kCeilingMarginDb = -0.5f;
+    constexpr float kModeFadeSeconds = 0.01f;    // crossfade between modes
+    constexpr int kWarmupSettle = 32;            // extra samples for the oversampling filters to settle
+}
+
+TruePeakLimiter::TruePeakLimiter(int oversamplingStages)
+    : oversampling(2, static_cast<size_t>(oversamplingStages), juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR),
+      oversamplingFactor(1 << oversamplingStages)
+{
+}
+
+void TruePeakLimiter::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    oversampling.initProcessing(spec.maximumBlockSize);
+
+    const double oversampledRate = spec.sampleRate * oversamplingFactor;
+
+    // Lookahead is a multiple of the oversampling factor so the reported
+    // latency is a whole number of base-rate samples
+    const int baseLookahead = juce::jmax(1, static_cast<int>(std::ceil(kLookaheadSeconds * spec.sampleRate)));
+    lookahead = baseLookahead * oversamplingFactor;
+
+    const auto window = static_cast<size_t>(lookahead + 1);
+    delayLine.assign(static_cast<size_t>(lookahead) * 2, 0.0f);
+    minWindow.assign(window, 1.0f);
+    minDeque.assign(window, 0);
+    boxWindow.assign(window, 1.0f);
+
+    releaseCoeff = std::exp(-1.0f / (static_cast<float>(oversampledRate) * kReleaseSeconds));
+
+    const float latency = getLatencyInSamples();
+    offDelay.prepare(static_cast<int>(spec.numChannels), static_cast<int>(std::ceil(latency)));
+    offDelay.setDelay(latency);
+    offBuffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+
+    const float fadeSamples = juce::jmax(1.0f, kModeFadeSeconds * static_cast<float>(spec.sampleRate));
+    pathStep = 1.0f / fadeSamples;
+    limitStep = 1.0f / (fadeSamples * static_cast<float>(oversamplingFactor));
+    warmupLength = static_cast<int>(std::ceil(latency)) + kWarmupSettle;
+
+    reset();
+}
+
+void TruePeakLimiter::reset()
+{
+    offDelay.reset();
+    resetPath();
+
+    pathRunning = false;
+    fresh = true;
+    pathWeight = 0.0f;
+    warmupRemaining = 0;
+}
+
+void TruePeakLimiter::resetPath()
+{
+    oversampling.reset();
+
+    std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+    std::fill(boxWindow.begin(), boxWindow.end(), 1.0f);
+    writePos = 0;
+    dequeHead = dequeTail = 0;
+    sampleCounter = 0;
+    boxSum = static_cast<double>(boxWindow.size());
+    releaseState = 1.0f;
+}
+
+float TruePeakLimiter::getLatencyInSamples() const
+{
+    return oversampling.getLatencyInSamples() + static_cast<float>(lookahead / oversamplingFactor);
+}
+
+void TruePeakLimiter::process(juce::dsp::AudioBlock<float>& block, Mode mode, float ceilingGain)
+{
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int numChannels = static_cast<int>(block.getNumChannels());
+    const bool pathWanted = mode != Mode::off;
+
+    if (pathWanted)
+        limitTarget = mode == Mode::limit ? 1.0f : 0.0f;
+
+    if (pathWanted && !pathRunning)
+    {
+        // The oversampled path starts from clean state. Its output isn't
+        // valid until the filters and delay line have filled, so the fade
+        // from Off waits for that. Straight after reset() both paths start
+        // from silence and there is nothing to fade from
+        resetPath();
+        pathRunning = true;
+        limitWeight = limitTarget;
+        pathWeight = fresh ? 1.0f : 0.0f;
+        warmupRemaining = fresh ? 0 : warmupLength;
+    }
+
+    fresh = false;
+
+    if (!pathRunning)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = block.getChannelPointer(static_cast<size_t>(ch));
+            offDelay.process(ch, data, data, numSamples);
+        }
+        return;
+    }
+
+    // The Off path is always fed, so it is current whenever a fade needs it
+    const bool fading = !pathWanted || pathWeight < 1.0f;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* data = block.getChannelPointer(static_cast<size_t>(ch));
+        if (fading)
+            offDelay.process(ch, data, offBuffer.getWritePointer(ch), numSamples);
+        else
+            offDelay.write(ch, data, numSamples);
+    }
+
+    processPath(block, ceilingGain);
+
+    if (!fading)
+        return;
+
+    // Crossfade the Off output against the oversampled path
+    float weight = pathWeight;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (warmupRemaining > 0)
+            --warmupRemaining;
+        else
+            weight = pathWanted ? juce::jmin(1.0f, weight + pathStep) : juce::jmax(0.0f, weight - pathStep);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = block.getChannelPointer(static_cast<size_t>(ch));
+            const float off = offBuffer.getSample(ch, i);
+            data[i] = off + (data[i] - off) * weight;
+        }
+    }
+
+    pathWeight = weight;
+
+    // Faded out completely: Off alone from the next block
+    if (!pathWanted && pathWeight <= 0.0f)
+        pathRunning = false;
+}
+
+void TruePeakLimiter::processPath(juce::dsp::AudioBlock<float>& block, float ceilingGain)
+{
+    auto oversampledBlock = oversampling.processSamplesUp(block);
+
+    const float ceiling = ceilingGain * juce::Decibels::decibelsToGain(kCeilingMarginDb);
+    const float knee = kClipKnee * ceiling;
+    const float kneeRange = ceiling - knee;
+
+    const size_t numChannels = juce::jmin<size_t>(oversampledBlock.getNumChannels(), 2);
+    const int window = lookahead + 1;
+    const double boxScale = 1.0 / window;
+
+    float* channels[2] = { oversampledBlock.getChannelPointer(0),
+                           numChannels > 1 ? oversampledBlock.getChannelPointer(1) : nullptr };
+
+    for (size_t i = 0; i < oversampledBlock.getNumSamples(); ++i)
+    {
+        // Stereo-linked gain needed to keep this sample under the ceiling
+        float peak = 0.0f;
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            peak = std::max(peak, std::abs(channels[ch][i]));
+
+        const float targetGain = peak > ceiling ? ceiling / peak : 1.0f;
+
+        // Sliding minimum over the lookahead window (monotonic deque of sample indices)
+        const auto slot = static_cast<size_t>(sampleCounter % window);
+
+        while (dequeTail > dequeHead && minDeque[static_cast<size_t>(dequeHead % window)] <= sampleCounter - window)
+            ++dequeHead;
+
+        while (dequeTail > dequeHead
+               && minWindow[static_cast<size_t>(minDeque[static_cast<size_t>((dequeTail - 1) % window)] % window)] >= targetGain)
+            --dequeTail;
+
+        minWindow[slot] = targetGain;
+        minDeque[static_cast<size_t>(dequeTail % window)] = sampleCounter;
+        ++dequeTail;
+
+        const float heldGain = minWindow[static_cast<size_t>(minDeque[static_cast<size_t>(dequeHead % window)] % window)];
+
+        // Instant attack to the held minimum, exponential release
+        releaseState = heldGain < releaseState ? heldGain
+                                               : heldGain + (releaseState - heldGain) * releaseCoeff;
+
+        // Box smoothing over the window: reaches the held gain exactly when
+        // the delayed peak sample comes out
+        boxSum += releaseState - boxWindow[slot];
+        boxWindow[slot] = releaseState;
+        const float gain = static_cast<float>(boxSum * boxScale);
+
+        // Clip <-> Limit crossfade
+        if (limitWeight != limitTarget)
+            limitWeight = limitTarget > limitWeight ? juce::jmin(limitTarget, limitWeight + limitStep)
+                                                    : juce::jmax(limitTarget, limitWeight - limitStep);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            // Through the lookahead delay line, for the limiter's latency
+            auto& delayed = delayLine[static_cast<size_t>(writePos) * 2 + ch];
+            const float x = delayed;
+            delayed = channels[ch][i];
+
+            const float limited = x * gain;
+            if (limitWeight >= 1.0f)
+            {
+                channels[ch][i] = limited;
+                continue;
+            }
+
+            // Soft knee that approaches the ceiling asymptotically
+            float clipped = x;
+            const float absX = std::abs(x);
+            if (absX > knee)
+            {
+                const float shaped = knee + kneeRange * std::tanh((absX - knee) / kneeRange);
+                clipped = x > 0.0f ? shaped : -shaped;
+            }
+
+            channels[ch][i] = clipped + (limited - clipped) * limitWeight;
+        }
+
+        writePos = (writePos + 1) % lookahead;
+        ++sampleCounter;
+    }
+
+    oversampling.processSamplesDown(block);
+}
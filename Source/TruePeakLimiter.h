@@ -0,0 +1,89 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "LatencyDelay.h"
+
+/**
+ * Final output ceiling stage that works on the oversampled signal, so
+ * inter-sample peaks are caught as well as sample peaks.
+ *
+ * Uses the same oversampling design as the saturation stage (polyphase IIR
+ * half-band, same factor) so the ceiling matches what the drive stage sees.
+ *
+ *   Off   - the input delayed by the stage's latency (base rate only)
+ *   Clip  - soft knee clipper at the ceiling (knee from 95% of it)
+ *   Limit - stereo-linked lookahead limiter (sliding-minimum gain + box
+ *           smoothing)
+ *
+ * Clip and Limit hold the oversampled signal 0.5 dB under the ceiling, as
+ * headroom for the downsampling filters' overshoot.
+ *
+ * Every mode has the limiter's latency (oversampling + lookahead), so the
+ * plugin's latency doesn't depend on the mode and never has to be reported
+ * again while audio runs. Mode changes crossfade over 10 ms instead
+ * of resetting: Clip and Limit share the oversampled path and the limiter's
+ * gain runs in both, and the Off path is fed all the time. Turning the
+ * ceiling on from Off starts the oversampled path and holds the fade until
+ * its output is valid.
+ */
+class TruePeakLimiter
+{
+public:
+    enum class Mode
+    {
+        off = 0,
+        clip,
+        limit
+    };
+
+    explicit TruePeakLimiter(int oversamplingStages);
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    /** Processes in place. ceilingGain is linear (e.g. -1 dBTP -> 0.891).
+        A different mode than the last call crossfades to it. */
+    void process(juce::dsp::AudioBlock<float>& block, Mode mode, float ceilingGain);
+
+    /** Latency in base-rate samples, the same in every mode. */
+    float getLatencyInSamples() const;
+
+private:
+    /** Clip and Limit, crossfaded by limitWeight. */
+    void processPath(juce::dsp::AudioBlock<float>& block, float ceilingGain);
+    void resetPath();
+
+    juce::dsp::Oversampling<float> oversampling;
+    const int oversamplingFactor;
+
+    // Off: the input padded to the same latency
+    LatencyDelay offDelay;
+    juce::AudioBuffer<float> offBuffer;  // Off output while it is crossfaded
+
+    // Mode crossfades
+    bool pathRunning = false;   // the oversampled path (Clip/Limit) is processing
+    bool fresh = true;          // nothing processed since reset()
+    float pathWeight = 0.0f;    // 0 = Off, 1 = oversampled path (per base-rate sample)
+    float pathStep = 0.0f;
+    float limitWeight = 0.0f;   // 0 = Clip, 1 = Limit (per oversampled sample)
+    float limitTarget = 0.0f;
+    float limitStep = 0.0f;
+    int warmupLength = 0;       // base-rate samples before the path's output is valid
+    int warmupRemaining = 0;
+
+    // Lookahead limiter state (oversampled rate). Clip runs through the
+    // same delay line, for the same latency
+    int lookahead = 0;                  // in oversampled samples, multiple of the factor
+    std::vector<float> delayLine;       // interleaved per channel: [pos * 2 + ch]
+    std::vector<float> minWindow;       // gain values for the sliding minimum
+    std::vector<juce::int64> minDeque;  // sample indices (monotonic deque)
+    std::vector<float> boxWindow;       // values of the box smoother
+    int writePos = 0;
+    juce::int64 dequeHead = 0, dequeTail = 0;
+    juce::int64 sampleCounter = 0;
+    double boxSum = 0.0;
+    float releaseState = 1.0f;
+    float releaseCoeff = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TruePeakLimiter)
+};
@@ -0,0 +1,466 @@
+// Measures aliasing, THD+N and processing cost of the saturation stage for
+// every mode, drive level, sample rate and anti-aliasing setting (oversampling
+// factor, ADAA), to pick quality/cost defaults per mode.
+//
+// Signals are a stepped sine sweep and a three-tone multitone. All tones sit
+// on multiples of an odd FFT bin, so every harmonic and intermodulation
+// product lands on a multiple of that bin as well, while folded (aliased)
+// components fall between them. Energy outside the harmonic bins is counted
+// as aliasing.
+//
+// Writes <outputDir>/aliasing.csv (one row per measurement, easy to plot) and
+// <outputDir>/aliasing.json (per-setting summary with Pareto flags), and
+// prints the Pareto-optimal settings and the cost of the adaptive quality
+// tiers (4x, then 2x + ADAA, then 1x + ADAA) relative to 4x, which is what a
+// QualityGovernor step saves.
+//
+// Then checks the true-peak ceiling: hot signals (inter-sample peaks, a
+// near-Nyquist sine, a square wave) through Clip and Limit, with the output
+// measured by the plugin's own 4x true-peak meter (LevelMeter). Prints the
+// worst true peak over the ceiling per case and fails (exit code 1) if any
+// case overshoots by more than kCeilingTolerance.
+//
+// Builds on the headless DSP library (no plugin wrapper).
+//
+// Usage: DriveAliasingAnalyzer [outputDir] [drivePercent...]
+
+#include "../Source/DriveEngine.h"
+#include "../Source/LevelMeter.h"
+
+#include <iostream>
+
+namespace
+{
+    constexpr int kFftOrder = 14;
+    constexpr int kFftSize = 1 << kFftOrder;
+    constexpr int kHostBlockSize = 512;
+    constexpr int kWarmupSamples = 8192;
+    constexpr int kLeakageBins = 4;           // Blackman-Harris main lobe half-width
+    constexpr float kAmplitude = 0.5f;
+
+    const double sampleRates[] = { 44100.0, 48000.0, 96000.0 };
+    const double sweepFrequencies[] = { 1000.0, 3000.0, 5000.0, 8000.0, 12000.0 };
+    const int multitoneHarmonics[] = { 7, 29, 61 };
+    constexpr int kMultitoneBaseBin = 37;
+    const char* modeNames[] = { "tube", "tape", "transistor" };
+
+    struct Setting
+    {
+        int oversamplingStages = 2;
+        bool adaa = false;
+
+        juce::String getName() const { return juce::String(1 << oversamplingStages) + "x" + (adaa ? "+adaa" : ""); }
+    };
+
+    const Setting settings[] = { { 0, false }, { 0, true }, { 1, false }, { 1, true }, { 2, false }, { 2, true } };
+
+    // Ceiling check
+    constexpr float kCeilingDb = -1.0f;
+    constexpr double kCeilingTolerance = 0.1;  // dB, allowance for the meter's own interpolation error
+    constexpr int kCeilingTestSamples = 1 << 16;
+
+    /** Test signal for the ceiling check, frequency as a fraction of the sample rate. */
+    struct CeilingSignal
+    {
+        const char* name;
+        double frequency;
+        double phase;
+        bool square;
+    };
+
+    const CeilingSignal ceilingSignals[] = {
+        { "fs/4 sine, 45 deg", 0.25, 0.25 * juce::MathConstants<double>::pi, false },  // samples miss every crest by 3 dB
+        { "0.45 fs sine", 0.45, 0.0, false },
+        { "fs/6 sine", 1.0 / 6.0, 0.1, false },
+        { "fs/40 square", 1.0 / 40.0, 0.0, true },
+    };
+
+    /** Tones of one test signal, as multiples of an odd base bin. */
+    struct Signal
+    {
+        juce::String name;
+        int baseBin = 1;
+        std::vector<int> toneBins;
+    };
+
+    struct Measurement
+    {
+        double aliasingDb = 0.0;
+        double thdnDb = 0.0;
+        double nsPerSample = 0.0;
+    };
+
+    int nearestOddBin(double frequency, double sampleRate)
+    {
+        const int bin = juce::roundToInt(frequency * kFftSize / sampleRate);
+        return juce::jmax(1, bin | 1);
+    }
+
+    double toDb(double ratio)
+    {
+        return 10.0 * std::log10(juce::jmax(ratio, 1.0e-30));
+    }
+
+    Measurement measure(DriveEngine& engine, const Signal& signal, double sampleRate)
+    {
+        // Enough blocks for warm-up plus one FFT frame
+        const int totalSamples = kWarmupSamples + kFftSize;
+        juce::AudioBuffer<float> buffer(2, kHostBlockSize);
+        std::vector<float> capture(static_cast<size_t>(kFftSize) * 2, 0.0f);
+
+        DriveEngine::ProcessSetup setup;
+        setup.sampleRate = sampleRate;
+        setup.numChannels = 2;
+        engine.prepare(setup);
+
+        const float toneGain = kAmplitude / static_cast<float>(signal.toneBins.size());
+        juce::int64 ticks = 0;
+        int timedSamples = 0;
+
+        for (int start = 0; start < totalSamples; start += kHostBlockSize)
+        {
+            const int numSamples = juce::jmin(kHostBlockSize, totalSamples - start);
+            buffer.setSize(2, numSamples, false, false, true);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                double x = 0.0;
+                for (int bin : signal.toneBins)
+                    x += std::sin(juce::MathConstants<double>::twoPi * bin * (start + i) / kFftSize);
+
+                const float sample = static_cast<float>(x) * toneGain;
+                buffer.setSample(0, i, sample);
+                buffer.setSample(1, i, sample);
+            }
+
+            const auto t0 = juce::Time::getHighResolutionTicks();
+            engine.process(buffer.getArrayOfWritePointers(), 2, numSamples);
+            const auto t1 = juce::Time::getHighResolutionTicks();
+
+            if (start >= kWarmupSamples)
+            {
+                ticks += t1 - t0;
+                timedSamples += numSamples;
+                std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + numSamples,
+                          capture.begin() + (start - kWarmupSamples));
+            }
+        }
+
+        engine.reset();
+
+        juce::dsp::WindowingFunction<float> window(static_cast<size_t>(kFftSize),
+                                                   juce::dsp::WindowingFunction<float>::blackmanHarris, false);
+        window.multiplyWithWindowingTable(capture.data(), static_cast<size_t>(kFftSize));
+
+        juce::dsp::FFT fft(kFftOrder);
+        fft.performFrequencyOnlyForwardTransform(capture.data(), true);
+
+        double total = 0.0, tones = 0.0, harmonics = 0.0;
+
+        for (int bin = kLeakageBins + 1; bin < kFftSize / 2; ++bin)
+        {
+            const double power = static_cast<double>(capture[static_cast<size_t>(bin)]) * capture[static_cast<size_t>(bin)];
+            total += power;
+
+            const int offset = bin % signal.baseBin;
+            if (juce::jmin(offset, signal.baseBin - offset) <= kLeakageBins)
+                harmonics += power;
+
+            for (int toneBin : signal.toneBins)
+                if (std::abs(bin - toneBin) <= kLeakageBins)
+                    tones += power;
+        }
+
+        Measurement m;
+        m.aliasingDb = toDb((total - harmonics) / total);
+        m.thdnDb = toDb((total - tones) / total);
+        m.nsPerSample = juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9 / juce::jmax(1, timedSamples);
+        return m;
+    }
+
+    std::vector<Signal> makeSignals(double sampleRate)
+    {
+        std::vector<Signal> signals;
+
+        for (double frequency : sweepFrequencies)
+        {
+            if (frequency >= sampleRate * 0.45)
+                continue;
+
+            const int bin = nearestOddBin(frequency, sampleRate);
+            signals.push_back({ "sine" + juce::String(juce::roundToInt(frequency)), bin, { bin } });
+        }
+
+        Signal multitone { "multitone", kMultitoneBaseBin, {} };
+        for (int h : multitoneHarmonics)
+            multitone.toneBins.push_back(h * kMultitoneBaseBin);
+        signals.push_back(multitone);
+
+        return signals;
+    }
+
+    /** Summary of one mode / drive / sample rate / setting over all signals. */
+    struct Summary
+    {
+        int mode = 0;
+        float drive = 0.0f;
+        double sampleRate = 0.0;
+        Setting setting;
+        double worstAliasingDb = -300.0;
+        double worstThdnDb = -300.0;
+        double nsPerSample = 0.0;
+        bool pareto = false;
+    };
+
+    void markParetoFront(std::vector<Summary>& summaries)
+    {
+        // A setting is Pareto-optimal if no other setting for the same mode,
+        // drive and sample rate aliases less and costs less
+        for (auto& a : summaries)
+        {
+            a.pareto = true;
+            for (const auto& b : summaries)
+            {
+                if (&a == &b || a.mode != b.mode || a.drive != b.drive || a.sampleRate != b.sampleRate)
+                    continue;
+
+                const bool noWorse = b.worstAliasingDb <= a.worstAliasingDb && b.nsPerSample <= a.nsPerSample;
+                const bool better = b.worstAliasingDb < a.worstAliasingDb || b.nsPerSample < a.nsPerSample;
+                if (noWorse && better)
+                {
+                    a.pareto = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    /** Output true peak relative to the ceiling in dB (> 0 = over it), after warm-up. */
+    double measureCeilingOvershoot(DriveEngine& engine, const CeilingSignal& signal, double sampleRate)
+    {
+        DriveEngine::ProcessSetup setup;
+        setup.sampleRate = sampleRate;
+        setup.numChannels = 2;
+        engine.prepare(setup);
+
+        LevelMeter meter;
+        meter.prepare(2, kHostBlockSize);
+        meter.setTruePeakEnabled(true);
+
+        juce::AudioBuffer<float> buffer(2, kHostBlockSize);
+        const int totalSamples = kWarmupSamples + kCeilingTestSamples;
+        float truePeak = 0.0f;
+
+        for (int start = 0; start < totalSamples; start += kHostBlockSize)
+        {
+            const int numSamples = juce::jmin(kHostBlockSize, totalSamples - start);
+            buffer.setSize(2, numSamples, false, false, true);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const double x = std::sin(juce::MathConstants<double>::twoPi * signal.frequency * (start + i) + signal.phase);
+                const float sample = static_cast<float>(signal.square ? (x >= 0.0 ? 1.0 : -1.0) : x) * kAmplitude;
+                buffer.setSample(0, i, sample);
+                buffer.setSample(1, i, sample);
+            }
+
+            engine.process(buffer.getArrayOfWritePointers(), 2, numSamples);
+
+            // The meter runs over the warm-up too, so its interpolator is primed
+            meter.beginBlock();
+            meter.process(buffer.getArrayOfReadPointers(), 2, numSamples, nullptr);
+            if (start >= kWarmupSamples)
+                truePeak = juce::jmax(truePeak, meter.getBlockTruePeak());
+        }
+
+        engine.reset();
+        return juce::Decibels::gainToDecibels(truePeak, -300.0f) - kCeilingDb;
+    }
+
+    /** Runs the ceiling check and prints it. Returns false if a case overshoots. */
+    bool checkCeiling(DriveEngine& engine)
+    {
+        // Hot enough to drive both modes hard into the ceiling
+        DriveEngine::Parameters params;
+        params.drive = 100.0f;
+        params.output = 12.0f;
+        params.mix = 100.0f;
+        params.autoGain = false;
+        params.ceiling = kCeilingDb;
+
+        const char* ceilingModeNames[] = { "off", "clip", "limit" };
+        bool passed = true;
+
+        std::cout << "True-peak ceiling at " << kCeilingDb << " dBTP (output true peak over it, dB):" << std::endl;
+        std::cout << "rate	mode	signal	overshoot dB" << std::endl;
+
+        for (double sampleRate : sampleRates)
+        {
+            for (int ceilingMode = 1; ceilingMode <= 2; ++ceilingMode)
+            {
+                params.ceilingMode = ceilingMode;
+                engine.setParameters(params);
+
+                for (const auto& signal : ceilingSignals)
+                {
+                    const double overshoot = measureCeilingOvershoot(engine, signal, sampleRate);
+                    const bool ok = overshoot <= kCeilingTolerance;
+                    passed = passed && ok;
+
+                    std::cout << sampleRate << "\t" << ceilingModeNames[ceilingMode] << "\t" << signal.name << "\t"
+                              << juce::String(overshoot, 2) << (ok ? "" : "\tFAIL") << std::endl;
+                }
+            }
+        }
+
+        std::cout << (passed ? "Ceiling check PASSED" : "Ceiling check FAILED") << std::endl;
+        return passed;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const juce::File outputDir = argc > 1 ? juce::File::getCurrentWorkingDirectory().getChildFile(argv[1])
+                                          : juce::File::getCurrentWorkingDirectory();
+    std::vector<float> drives;
+    for (int i = 2; i < argc; ++i)
+        drives.push_back(juce::jlimit(0.0f, 100.0f, juce::String(argv[i]).getFloatValue()));
+    if (drives.empty())
+        drives = { 25.0f, 50.0f, 75.0f, 100.0f };
+
+    outputDir.createDirectory();
+
+    DriveEngine engine;
+
+    // Only the saturation stage: everything else neutral
+    DriveEngine::Parameters params;
+    params.pressure = 0.0f;
+    params.tone = 0.0f;
+    params.attack = 0.0f;
+    params.sustain = 0.0f;
+    params.mix = 100.0f;
+    params.stereoWidth = 100.0f;
+    params.autoGain = false;
+    params.ceilingMode = 0;
+    params.output = 0.0f;
+
+    // The ADAA tables are built in the background
+    while (engine.getAdaaTables() == nullptr)
+        juce::Thread::sleep(5);
+
+    juce::String csv = "mode,drive,sampleRate,oversampling,adaa,signal,aliasingDb,thdnDb,nsPerSample\n";
+    std::vector<Summary> summaries;
+
+    for (double sampleRate : sampleRates)
+    {
+        const auto signals = makeSignals(sampleRate);
+
+        for (int mode = 0; mode < static_cast<int>(std::size(modeNames)); ++mode)
+        {
+            for (float drive : drives)
+            {
+                for (const auto& setting : settings)
+                {
+                    params.mode = mode;
+                    params.drive = drive;
+                    params.oversampling = setting.oversamplingStages;
+                    params.adaa = setting.adaa;
+                    engine.setParameters(params);
+
+                    Summary summary { mode, drive, sampleRate, setting };
+                    double nsTotal = 0.0;
+
+                    for (const auto& signal : signals)
+                    {
+                        const auto m = measure(engine, signal, sampleRate);
+                        nsTotal += m.nsPerSample;
+                        summary.worstAliasingDb = juce::jmax(summary.worstAliasingDb, m.aliasingDb);
+                        summary.worstThdnDb = juce::jmax(summary.worstThdnDb, m.thdnDb);
+
+                        csv << modeNames[mode] << "," << drive << "," << sampleRate << ","
+                            << (1 << setting.oversamplingStages) << "," << (setting.adaa ? 1 : 0) << ","
+                            << signal.name << "," << juce::String(m.aliasingDb, 2) << ","
+                            << juce::String(m.thdnDb, 2) << "," << juce::String(m.nsPerSample, 2) << "\n";
+                    }
+
+                    summary.nsPerSample = nsTotal / static_cast<double>(signals.size());
+                    summaries.push_back(summary);
+                }
+            }
+
+            std::cout << "." << std::flush;
+        }
+    }
+
+    std::cout << std::endl;
+    markParetoFront(summaries);
+
+    juce::Array<juce::var> results;
+    for (const auto& s : summaries)
+    {
+        auto* obj = new juce::DynamicObject();
+        obj->setProperty("mode", modeNames[s.mode]);
+        obj->setProperty("drive", s.drive);
+        obj->setProperty("sampleRate", s.sampleRate);
+        obj->setProperty("oversampling", 1 << s.setting.oversamplingStages);
+        obj->setProperty("adaa", s.setting.adaa);
+        obj->setProperty("worstAliasingDb", s.worstAliasingDb);
+        obj->setProperty("worstThdnDb", s.worstThdnDb);
+        obj->setProperty("nsPerSample", s.nsPerSample);
+        obj->setProperty("pareto", s.pareto);
+        results.add(juce::var(obj));
+    }
+
+    const auto csvFile = outputDir.getChildFile("aliasing.csv");
+    const auto jsonFile = outputDir.getChildFile("aliasing.json");
+    csvFile.replaceWithText(csv);
+    jsonFile.replaceWithText(juce::JSON::toString(juce::var(results)));
+
+    std::cout << "Pareto-optimal settings (worst-case aliasing vs ns/sample):" << std::endl;
+    std::cout << "mode\tdrive\trate\tsetting\taliasing dB\tTHD+N dB\tns/sample" << std::endl;
+
+    for (const auto& s : summaries)
+    {
+        if (!s.pareto)
+            continue;
+
+        std::cout << modeNames[s.mode] << "\t" << s.drive << "\t" << s.sampleRate << "\t"
+                  << s.setting.getName() << "\t" << juce::String(s.worstAliasingDb, 1) << "\t"
+                  << juce::String(s.worstThdnDb, 1) << "\t" << juce::String(s.nsPerSample, 1) << std::endl;
+    }
+
+    // Adaptive quality steps: 4x -> 2x + ADAA -> 1x + ADAA, averaged over
+    // drives and sample rates
+    std::cout << "Adaptive quality tiers (ns/sample, relative to 4x):" << std::endl;
+    std::cout << "mode\t4x\t2x+adaa\t1x+adaa" << std::endl;
+
+    for (int mode = 0; mode < static_cast<int>(std::size(modeNames)); ++mode)
+    {
+        auto averageCost = [&](int stages, bool adaa)
+        {
+            double total = 0.0;
+            int count = 0;
+            for (const auto& s : summaries)
+            {
+                if (s.mode == mode && s.setting.oversamplingStages == stages && s.setting.adaa == adaa)
+                {
+                    total += s.nsPerSample;
+                    ++count;
+                }
+            }
+            return total / juce::jmax(1, count);
+        };
+
+        const double top = averageCost(2, false);
+        const double twoX = averageCost(1, true);
+        const double oneX = averageCost(0, true);
+
+        std::cout << modeNames[mode] << "\t" << juce::String(top, 1) << "\t"
+                  << juce::String(twoX, 1) << " (" << juce::String(twoX / top, 2) << ")\t"
+                  << juce::String(oneX, 1) << " (" << juce::String(oneX / top, 2) << ")" << std::endl;
+    }
+
+    std::cout << "Wrote " << csvFile.getFullPathName() << " and " << jsonFile.getFullPathName() << std::endl;
+
+    return checkCeiling(engine) ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+// Measures processing cost for combinations of host block size and internal
+// chunk size, to pick kDefaultInternalBlockSize. With "offline" the engine
+// is prepared for non-realtime use, which runs the channels on separate threads.
+// Builds on the headless DSP library (no plugin wrapper).
+//
+// Usage: DriveBlockSizeBenchmark [sampleRate] [seconds] [offline]
+
+#include "../Source/DriveEngine.h"
+
+#include <iostream>
+
+namespace
+{
+    double nsPerSample(int internalBlockSize, int hostBlockSize, double sampleRate, double seconds, bool offline)
+    {
+        DriveEngine engine;
+
+        // Busy drum-bus settings: every stage active
+        DriveEngine::Parameters params;
+        params.drive = 60.0f;
+        params.pressure = 50.0f;
+        params.tone = 30.0f;
+        params.attack = 40.0f;
+        params.sustain = -20.0f;
+        params.stereoWidth = 130.0f;
+        params.autoGain = true;
+        engine.setParameters(params);
+
+        DriveEngine::ProcessSetup setup;
+        setup.sampleRate = sampleRate;
+        setup.numChannels = 2;
+        setup.internalBlockSize = internalBlockSize;
+        setup.nonRealtime = offline;
+        engine.prepare(setup);
+
+        juce::AudioBuffer<float> buffer(2, hostBlockSize);
+        juce::Random random(42);
+
+        const int numBlocks = juce::jmax(1, static_cast<int>(seconds * sampleRate / hostBlockSize));
+        juce::int64 ticks = 0;
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < hostBlockSize; ++i)
+                    buffer.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.5f);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            engine.process(buffer.getArrayOfWritePointers(), 2, hostBlockSize);
+            ticks += juce::Time::getHighResolutionTicks() - start;
+        }
+
+        return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9 / (static_cast<double>(numBlocks) * hostBlockSize);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const double sampleRate = argc > 1 ? juce::String(argv[1]).getDoubleValue() : 48000.0;
+    const double seconds = argc > 2 ? juce::String(argv[2]).getDoubleValue() : 10.0;
+    const bool offline = argc > 3 && juce::String(argv[3]) == "offline";
+
+    const int hostBlockSizes[] = { 32, 64, 256, 1024, 4096, 16384 };
+    const int internalBlockSizes[] = { 16, 32, 64, 128, 256, 512, 2048 };
+
+    std::cout << "ns/sample at " << sampleRate << " Hz (" << seconds << " s per cell, "
+              << (offline ? "offline" : "realtime") << ")" << std::endl;
+    std::cout << "host\\chunk";
+    for (int chunk : internalBlockSizes)
+        std::cout << "\t" << chunk;
+    std::cout << std::endl;
+
+    for (int host : hostBlockSizes)
+    {
+        std::cout << host;
+        for (int chunk : internalBlockSizes)
+            std::cout << "\t" << juce::String(nsPerSample(chunk, host, sampleRate, seconds, offline), 1);
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
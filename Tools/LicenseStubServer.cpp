@@ -0,0 +1,114 @@
+// Local stand-in for the BeatConnect license API, for testing activation
+// without the network. Answers every request with a canned JSON response
+// for the chosen scenario and logs what the SDK asked for.
+//
+// Point the plugin at it with DRIVE_LICENSE_SERVER=http://127.0.0.1:<port>
+//
+// Usage: DriveLicenseStubServer [port] [valid|invalid|revoked|max_reached|server_error|slow]
+
+#include <juce_core/juce_core.h>
+
+#include <iostream>
+
+namespace
+{
+    struct Response
+    {
+        int statusCode = 200;
+        juce::String body;
+        int delayMs = 0;
+    };
+
+    Response makeResponse(const juce::String& scenario)
+    {
+        auto license = [](bool valid, const char* status) {
+            juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+            obj->setProperty("valid", valid);
+            obj->setProperty("status", status);
+            obj->setProperty("activationCode", "TEST-0000-0000-0000");
+            obj->setProperty("machineId", "stub-machine");
+            obj->setProperty("activatedAt", juce::Time::getCurrentTime().toISO8601(true));
+            obj->setProperty("currentActivations", 1);
+            obj->setProperty("maxActivations", 3);
+            return juce::JSON::toString(juce::var(obj.get()), true);
+        };
+
+        if (scenario == "invalid")      return { 404, license(false, "invalid") };
+        if (scenario == "revoked")      return { 403, license(false, "revoked") };
+        if (scenario == "max_reached")  return { 409, license(false, "max_reached") };
+        if (scenario == "server_error") return { 500, "{\"error\":\"stub server error\"}" };
+        if (scenario == "slow")         return { 200, license(true, "valid"), 5000 };
+        return { 200, license(true, "valid") };
+    }
+
+    juce::String readRequest(juce::StreamingSocket& socket)
+    {
+        juce::MemoryBlock data;
+        char chunk[4096];
+
+        // Headers, then as much body as Content-Length says
+        for (;;)
+        {
+            if (socket.waitUntilReady(true, 2000) != 1)
+                break;
+
+            const int n = socket.read(chunk, sizeof(chunk), false);
+            if (n <= 0)
+                break;
+
+            data.append(chunk, static_cast<size_t>(n));
+            const auto text = data.toString();
+            const int headerEnd = text.indexOf("\r\n\r\n");
+            if (headerEnd < 0)
+                continue;
+
+            const auto lengthLine = text.substring(0, headerEnd).fromFirstOccurrenceOf("content-length:", false, true);
+            const int contentLength = lengthLine.upToFirstOccurrenceOf("\r\n", false, false).trim().getIntValue();
+            if (text.length() - (headerEnd + 4) >= contentLength)
+                return text;
+        }
+
+        return data.toString();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int port = argc > 1 ? juce::String(argv[1]).getIntValue() : 8787;
+    const juce::String scenario = argc > 2 ? juce::String(argv[2]) : juce::String("valid");
+    const auto response = makeResponse(scenario);
+
+    juce::StreamingSocket listener;
+    if (!listener.createListener(port, "127.0.0.1"))
+    {
+        std::cerr << "Could not listen on port " << port << std::endl;
+        return 1;
+    }
+
+    std::cout << "License stub on http://127.0.0.1:" << port << " answering '" << scenario
+              << "' (HTTP " << response.statusCode << ")" << std::endl;
+
+    for (;;)
+    {
+        std::unique_ptr<juce::StreamingSocket> client(listener.waitForNextConnection());
+        if (client == nullptr)
+            continue;
+
+        const auto request = readRequest(*client);
+        std::cout << juce::Time::getCurrentTime().toString(false, true, true, true) << "  "
+                  << request.upToFirstOccurrenceOf("\r\n", false, false) << std::endl;
+
+        if (response.delayMs > 0)
+            juce::Thread::sleep(response.delayMs);
+
+        const auto body = response.body.toStdString();
+        const juce::String reply = "HTTP/1.1 " + juce::String(response.statusCode) + (response.statusCode == 200 ? " OK" : " Error") + "\r\n"
+                                 + "Content-Type: application/json\r\n"
+                                 + "Content-Length: " + juce::String(static_cast<int>(body.size())) + "\r\n"
+                                 + "Connection: close\r\n\r\n"
+                                 + response.body;
+
+        client->write(reply.toRawUTF8(), static_cast<int>(reply.getNumBytesAsUTF8()));
+        client->close();
+    }
+}
@@ -0,0 +1,324 @@
+// Runs many DriveAudioProcessor instances from a pool of worker threads the
+// way a multi-core DAW schedules tracks: every audio callback, the workers
+// pull instances off a shared counter until all of them have processed the
+// block, then wait for the next callback. Each instance has its own buffer.
+//
+// For each instance count and thread count it reports:
+//  - throughput, as realtime streams (instance-seconds of audio per second)
+//  - per-instance processBlock time, p50 and p99
+//  - worst callback, as a share of the block's real-time budget
+//  - scaling efficiency: throughput over (threads x the one-thread throughput)
+// and once, the memory per instance (the processor's own report, plus the
+// resident set growth on Linux).
+//
+// Efficiency that falls off as threads are added, beyond what the machine's
+// memory bandwidth explains, points at false sharing or contention on state
+// shared between instances.
+//
+// Usage: DriveMultiInstanceBenchmark [maxInstances] [maxThreads] [seconds] [blockSize] [sampleRate]
+
+#include "../Source/PluginProcessor.h"
+#include "../Source/ParameterIDs.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+ #include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr int kMaxInstances = 512;
+
+    /** Resident set size in bytes, or 0 where it isn't available. */
+    size_t getResidentBytes()
+    {
+       #if defined(__linux__)
+        std::ifstream statm("/proc/self/statm");
+        size_t totalPages = 0, residentPages = 0;
+        if (statm >> totalPages >> residentPages)
+            return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+       #endif
+        return 0;
+    }
+
+    void setParameter(DriveAudioProcessor& processor, const char* id, float value)
+    {
+        auto* parameter = processor.getAPVTS().getParameter(id);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    /** Busy drum-bus settings: every stage active. */
+    void applyBusySettings(DriveAudioProcessor& processor)
+    {
+        setParameter(processor, ParameterIDs::drive, 60.0f);
+        setParameter(processor, ParameterIDs::pressure, 50.0f);
+        setParameter(processor, ParameterIDs::tone, 30.0f);
+        setParameter(processor, ParameterIDs::attack, 40.0f);
+        setParameter(processor, ParameterIDs::sustain, -20.0f);
+        setParameter(processor, ParameterIDs::stereoWidth, 130.0f);
+        setParameter(processor, ParameterIDs::autoGain, 1.0f);
+    }
+
+    struct Track
+    {
+        std::unique_ptr<DriveAudioProcessor> processor;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+    };
+
+    struct Result
+    {
+        double streams = 0.0;       // instance-seconds of audio per second
+        double p50Us = 0.0;
+        double p99Us = 0.0;
+        double worstCallback = 0.0; // share of the block duration
+    };
+
+    /**
+     * One callback per block: the calling thread and numThreads - 1 workers
+     * process instances until the shared counter runs out.
+     */
+    class CallbackRunner
+    {
+    public:
+        CallbackRunner(std::vector<Track>& tracksIn, const juce::AudioBuffer<float>& sourceIn, int numInstancesIn,
+                       int numThreads, size_t maxCallsPerThread)
+            : tracks(tracksIn), source(sourceIn), numInstances(numInstancesIn), times(static_cast<size_t>(numThreads))
+        {
+            for (auto& t : times)
+                t.reserve(maxCallsPerThread);
+
+            for (int i = 1; i < numThreads; ++i)
+                workers.emplace_back([this, i] { workerLoop(i); });
+        }
+
+        ~CallbackRunner()
+        {
+            quit.store(true);
+            generation.fetch_add(1);
+            for (auto& w : workers)
+                w.join();
+        }
+
+        /** Processes the tracks once, returns the callback's wall time in seconds. */
+        double runCallback()
+        {
+            // A worker still leaving the last callback may already take an
+            // instance from the reset counter, so its count must not be lost
+            finished.store(0);
+            nextInstance.store(0);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            generation.fetch_add(1, std::memory_order_release);
+            processInstances(0);
+
+            while (finished.load(std::memory_order_acquire) < numInstances)
+                std::this_thread::yield();
+
+            return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        }
+
+        /** processBlock times of every call so far, in microseconds. */
+        std::vector<double> collectTimes() const
+        {
+            std::vector<double> all;
+            for (const auto& t : times)
+                all.insert(all.end(), t.begin(), t.end());
+            return all;
+        }
+
+    private:
+        void workerLoop(int threadIndex)
+        {
+            juce::uint64 seen = 0;
+
+            for (;;)
+            {
+                // Spin (with yields) like a DAW's audio workers
+                juce::uint64 current;
+                while ((current = generation.load(std::memory_order_acquire)) == seen)
+                    std::this_thread::yield();
+
+                seen = current;
+                if (quit.load())
+                    return;
+
+                processInstances(threadIndex);
+            }
+        }
+
+        void processInstances(int threadIndex)
+        {
+            auto& threadTimes = times[static_cast<size_t>(threadIndex)];
+
+            for (;;)
+            {
+                const int index = nextInstance.fetch_add(1, std::memory_order_relaxed);
+                if (index >= numInstances)
+                    return;
+
+                auto& track = tracks[static_cast<size_t>(index)];
+                for (int ch = 0; ch < track.buffer.getNumChannels(); ++ch)
+                    track.buffer.copyFrom(ch, 0, source, ch, 0, track.buffer.getNumSamples());
+
+                const auto start = juce::Time::getHighResolutionTicks();
+                track.processor->processBlock(track.buffer, track.midi);
+                const auto end = juce::Time::getHighResolutionTicks();
+
+                threadTimes.push_back(juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e6);
+                finished.fetch_add(1, std::memory_order_release);
+            }
+        }
+
+        std::vector<Track>& tracks;
+        const juce::AudioBuffer<float>& source;
+        const int numInstances;
+        std::vector<std::vector<double>> times;  // per thread
+        std::vector<std::thread> workers;
+
+        // Each on its own cache line, so the bookkeeping doesn't measure itself
+        alignas(64) std::atomic<juce::uint64> generation { 0 };
+        alignas(64) std::atomic<int> nextInstance { 0 };
+        alignas(64) std::atomic<int> finished { 0 };
+        alignas(64) std::atomic<bool> quit { false };
+    };
+
+    double percentile(std::vector<double>& values, double fraction)
+    {
+        if (values.empty())
+            return 0.0;
+
+        const auto nth = values.begin()
+                         + static_cast<std::ptrdiff_t>(fraction * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), nth, values.end());
+        return *nth;
+    }
+
+    Result run(std::vector<Track>& tracks, const juce::AudioBuffer<float>& source, int numInstances, int numThreads,
+               int numCallbacks, double blockSeconds)
+    {
+        constexpr int kWarmupCallbacks = 8;
+        const auto maxCallsPerThread = static_cast<size_t>(numInstances)
+                                       * static_cast<size_t>(numCallbacks + kWarmupCallbacks);
+        CallbackRunner runner(tracks, source, numInstances, numThreads, maxCallsPerThread);
+
+        // Warm up caches, branch predictors and auto-gain tracking, untimed
+        for (int i = 0; i < kWarmupCallbacks; ++i)
+            runner.runCallback();
+
+        const auto warmupCalls = runner.collectTimes().size();
+        double totalSeconds = 0.0;
+        double worstSeconds = 0.0;
+
+        for (int i = 0; i < numCallbacks; ++i)
+        {
+            const double seconds = runner.runCallback();
+            totalSeconds += seconds;
+            worstSeconds = std::max(worstSeconds, seconds);
+        }
+
+        auto calls = runner.collectTimes();
+        calls.erase(calls.begin(), calls.begin() + static_cast<std::ptrdiff_t>(juce::jmin(warmupCalls, calls.size())));
+
+        Result result;
+        result.streams = totalSeconds > 0.0 ? numInstances * numCallbacks * blockSeconds / totalSeconds : 0.0;
+        result.p50Us = percentile(calls, 0.5);
+        result.p99Us = percentile(calls, 0.99);
+        result.worstCallback = worstSeconds / blockSeconds;
+        return result;
+    }
+
+    std::vector<int> doublingsUpTo(int first, int last)
+    {
+        std::vector<int> values;
+        for (int v = first; v < last; v *= 2)
+            values.push_back(v);
+        values.push_back(last);
+        return values;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const int hardwareThreads = juce::jmax(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int maxInstances = argc > 1 ? juce::jlimit(1, kMaxInstances, juce::String(argv[1]).getIntValue())
+                                      : kMaxInstances;
+    const int maxThreads = argc > 2 ? juce::jmax(1, juce::String(argv[2]).getIntValue()) : hardwareThreads;
+    const double seconds = argc > 3 ? juce::jmax(0.1, juce::String(argv[3]).getDoubleValue()) : 2.0;
+    const int blockSize = argc > 4 ? juce::jmax(16, juce::String(argv[4]).getIntValue()) : 256;
+    const double sampleRate = argc > 5 ? juce::String(argv[5]).getDoubleValue() : 48000.0;
+
+    const double blockSeconds = blockSize / sampleRate;
+    const int numCallbacks = juce::jmax(1, static_cast<int>(seconds / blockSeconds));
+
+    std::cout << "Multi-instance benchmark: up to " << maxInstances << " instances, up to " << maxThreads
+              << " threads (" << hardwareThreads << " hardware), " << blockSize << " samples at " << sampleRate
+              << " Hz, " << numCallbacks << " callbacks per run" << std::endl;
+
+    // Shared noise input, copied into each track's buffer before its callback
+    juce::AudioBuffer<float> source(2, blockSize);
+    juce::Random random(42);
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < blockSize; ++i)
+            source.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.5f);
+
+    const size_t residentBefore = getResidentBytes();
+
+    std::vector<Track> tracks(static_cast<size_t>(maxInstances));
+    for (auto& track : tracks)
+    {
+        track.processor = std::make_unique<DriveAudioProcessor>();
+        track.processor->setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        track.processor->setNonRealtime(false);
+        applyBusySettings(*track.processor);
+        track.processor->prepareToPlay(sampleRate, blockSize);
+        track.buffer.setSize(2, blockSize);
+    }
+
+    const size_t residentAfter = getResidentBytes();
+    const auto memory = tracks.front().processor->getMemoryReport();
+    std::cout << "Memory: " << memory.instanceBytes << " bytes/instance owned, " << memory.sharedBytes
+              << " bytes shared";
+    if (residentAfter > residentBefore)
+        std::cout << ", resident set +" << (residentAfter - residentBefore) / static_cast<size_t>(maxInstances)
+                  << " bytes/instance";
+    std::cout << std::endl << std::endl;
+
+    std::cout << "instances\tthreads\tstreams\tp50 us\tp99 us\tworst %\tefficiency" << std::endl;
+
+    for (int numInstances : doublingsUpTo(1, maxInstances))
+    {
+        double singleThreadStreams = 0.0;
+
+        for (int numThreads : doublingsUpTo(1, maxThreads))
+        {
+            const auto r = run(tracks, source, numInstances, numThreads, numCallbacks, blockSeconds);
+
+            if (numThreads == 1)
+                singleThreadStreams = r.streams;
+
+            // More threads than instances can't help, so they don't count
+            const int usefulThreads = juce::jmin(numThreads, numInstances);
+            const double efficiency = singleThreadStreams > 0.0
+                                          ? r.streams / (usefulThreads * singleThreadStreams)
+                                          : 0.0;
+
+            std::cout << numInstances << "\t" << numThreads
+                      << "\t" << juce::String(r.streams, 1)
+                      << "\t" << juce::String(r.p50Us, 2)
+                      << "\t" << juce::String(r.p99Us, 2)
+                      << "\t" << juce::String(r.worstCallback * 100.0, 1)
+                      << "\t" << juce::String(efficiency * 100.0, 1) << "%" << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,455 @@
+// Runs DriveAudioProcessor::processBlock across every mode and discrete
+// parameter combination and flags anything in the audio callback that isn't
+// real-time safe: heap allocation and release (operator new/delete, all
+// platforms) and, on Linux, mutex/condition variable waits and sleeping or
+// file I/O syscalls (interposed libc/libpthread functions). Catches regressions
+// such as per-block AudioBuffer copies or DBG calls; build Debug to cover DBG,
+// since it compiles to nothing in Release.
+//
+// Each combination is processed at several block sizes, with the continuous
+// parameters automated before every block. Parameter changes are made inside
+// the checked scope, the way JUCE's plugin wrappers deliver host automation
+// on the audio thread, and every block is checked, including the first one
+// after a combination change. Lock waits during the wrapper's notification
+// aren't counted (it takes JUCE's listener lock, uncontended); allocations
+// and syscalls there, including in listeners, are.
+//
+// Combinations also cover how the settings arrive and what the input is:
+// through the parameters or as a setStateInformation() snapshot (loaded on
+// the calling thread, unchecked, and picked up by the first checked block),
+// and stereo input or identical channels long enough for the engine to run
+// one strip for both, followed by stereo input (the second strip resumes
+// from the first's state).
+//
+// With -DDRIVE_ENABLE_RTSAN=ON on a compiler that supports it (Clang 20+),
+// the checked blocks also run under RealtimeSanitizer, which covers every
+// blocking libc call on all platforms and stops at the first violation with a
+// stack trace.
+//
+// Returns 1 if anything was flagged, so it can gate CI.
+//
+// Usage: DriveRealtimeSafetyCheck [blocksPerSize]
+
+#include "../Source/PluginProcessor.h"
+#include "../Source/ParameterIDs.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <new>
+
+#if defined(__linux__)
+ #include <dlfcn.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <time.h>
+ #include <unistd.h>
+#endif
+
+#if defined(__has_feature)
+ #if __has_feature(realtime_sanitizer)
+  #include <sanitizer/rtsan_interface.h>
+  #define DRIVE_RTSAN 1
+ #endif
+#endif
+
+#ifndef DRIVE_RTSAN
+ #define DRIVE_RTSAN 0
+#endif
+
+//==============================================================================
+// Interception
+//==============================================================================
+
+namespace
+{
+    thread_local bool inAudioCallback = false;
+    thread_local bool inWrapperNotification = false;
+
+    struct Violations
+    {
+        std::atomic<int> allocations { 0 };
+        std::atomic<int> deallocations { 0 };
+        std::atomic<int> locks { 0 };
+        std::atomic<int> syscalls { 0 };
+
+        int total() const { return allocations.load() + deallocations.load() + locks.load() + syscalls.load(); }
+        void clear() { allocations = 0; deallocations = 0; locks = 0; syscalls = 0; }
+    };
+
+    Violations violations;
+
+    // Stack of the first violation since the last clear, taken with the
+    // flag cleared so capturing it doesn't count (or recurse)
+    juce::String firstViolation;
+    bool hasFirstViolation = false;
+
+    void flag(std::atomic<int>& counter, const char* what)
+    {
+        if (!inAudioCallback || (inWrapperNotification && &counter == &violations.locks))
+            return;
+
+        ++counter;
+
+        if (!hasFirstViolation)
+        {
+            inAudioCallback = false;
+            hasFirstViolation = true;
+            firstViolation = juce::String(what) + "\n" + juce::SystemStats::getStackBacktrace();
+            inAudioCallback = true;
+        }
+    }
+
+    /**
+     * Marks a host wrapper's parameter notification: its listener lock isn't
+     * counted. Allocations and syscalls are, and so is everything a listener
+     * does apart from locking.
+     */
+    struct ScopedWrapperNotification
+    {
+        ScopedWrapperNotification()
+        {
+            inWrapperNotification = true;
+           #if DRIVE_RTSAN
+            __rtsan_disable();
+           #endif
+        }
+
+        ~ScopedWrapperNotification()
+        {
+           #if DRIVE_RTSAN
+            __rtsan_enable();
+           #endif
+            inWrapperNotification = false;
+        }
+    };
+
+    /** Marks the calling thread as inside the audio callback for its lifetime. */
+    struct ScopedAudioCallback
+    {
+        ScopedAudioCallback()
+        {
+            inAudioCallback = true;
+           #if DRIVE_RTSAN
+            __rtsan_realtime_enter();
+           #endif
+        }
+
+        ~ScopedAudioCallback()
+        {
+           #if DRIVE_RTSAN
+            __rtsan_realtime_exit();
+           #endif
+            inAudioCallback = false;
+        }
+    };
+
+    void* allocate(std::size_t size)
+    {
+        flag(violations.allocations, "allocation");
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* allocateAligned(std::size_t size, std::size_t alignment)
+    {
+        flag(violations.allocations, "allocation");
+       #if defined(_WIN32)
+        return _aligned_malloc(size == 0 ? 1 : size, alignment);
+       #else
+        void* ptr = nullptr;
+        return posix_memalign(&ptr, juce::jmax(alignment, sizeof(void*)), size == 0 ? 1 : size) == 0 ? ptr : nullptr;
+       #endif
+    }
+
+    void release(void* ptr)
+    {
+        if (ptr != nullptr)
+            flag(violations.deallocations, "deallocation");
+        std::free(ptr);
+    }
+
+    void releaseAligned(void* ptr)
+    {
+        if (ptr != nullptr)
+            flag(violations.deallocations, "deallocation");
+       #if defined(_WIN32)
+        _aligned_free(ptr);
+       #else
+        std::free(ptr);
+       #endif
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    if (auto* ptr = allocate(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (auto* ptr = allocateAligned(size, static_cast<std::size_t>(alignment)))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* ptr) noexcept { release(ptr); }
+void operator delete[](void* ptr) noexcept { release(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { release(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { release(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { release(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { release(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { releaseAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { releaseAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { releaseAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { releaseAligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(ptr); }
+
+#if defined(__linux__)
+// Definitions in the executable take precedence over libc's; each flags the
+// call and forwards to the next definition (libc's own)
+#define DRIVE_INTERPOSE(ret, name, counter, params, args)                                \
+    extern "C" ret name params                                                          \
+    {                                                                                   \
+        using Fn = ret (*) params;                                                      \
+        static Fn next = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, #name));                 \
+        flag(violations.counter, #name);                                                \
+        return next args;                                                               \
+    }
+
+DRIVE_INTERPOSE(int, pthread_mutex_lock, locks, (pthread_mutex_t* m), (m))
+DRIVE_INTERPOSE(int, pthread_rwlock_rdlock, locks, (pthread_rwlock_t* l), (l))
+DRIVE_INTERPOSE(int, pthread_rwlock_wrlock, locks, (pthread_rwlock_t* l), (l))
+DRIVE_INTERPOSE(int, pthread_cond_wait, locks, (pthread_cond_t* c, pthread_mutex_t* m), (c, m))
+DRIVE_INTERPOSE(int, pthread_cond_timedwait, locks, (pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t), (c, m, t))
+DRIVE_INTERPOSE(int, sem_wait, locks, (sem_t* s), (s))
+DRIVE_INTERPOSE(int, nanosleep, syscalls, (const struct timespec* req, struct timespec* rem), (req, rem))
+DRIVE_INTERPOSE(int, usleep, syscalls, (useconds_t us), (us))
+DRIVE_INTERPOSE(ssize_t, read, syscalls, (int fd, void* buf, size_t count), (fd, buf, count))
+DRIVE_INTERPOSE(ssize_t, write, syscalls, (int fd, const void* buf, size_t count), (fd, buf, count))
+
+#undef DRIVE_INTERPOSE
+#endif
+
+//==============================================================================
+// Test run
+//==============================================================================
+
+namespace
+{
+    constexpr int kMaxBlockSize = 512;
+    constexpr double kIdenticalSeconds = 0.2;  // > DriveEngine's dual-mono hold and fade
+    const int blockSizes[] = { 1, 17, 64, kMaxBlockSize };
+    const double sampleRates[] = { 44100.0, 96000.0 };
+    const char* modeNames[] = { "tube", "tape", "transistor" };
+
+    struct Combination
+    {
+        int mode = 0;
+        int oversampling = 0;
+        bool adaa = false;
+        int ceilingMode = 0;
+        bool autoGain = false;
+        bool bypass = false;
+        bool adaptiveQuality = false;
+        bool viaState = false;           // arrives as a setStateInformation() snapshot
+        bool identicalChannels = false;  // starts with identical L/R input
+
+        juce::String getName() const
+        {
+            return juce::String(modeNames[mode]) + " " + juce::String(1 << oversampling) + "x"
+                 + (adaa ? " adaa" : "") + " ceiling=" + juce::String(ceilingMode)
+                 + (autoGain ? " autogain" : "") + (bypass ? " bypass" : "")
+                 + (adaptiveQuality ? " adaptive" : "") + (viaState ? " via-state" : "")
+                 + (identicalChannels ? " identical-lr" : "");
+        }
+    };
+
+    /** Host automation as JUCE's plugin wrappers deliver it on the audio thread. */
+    void setParameter(DriveAudioProcessor& processor, const char* id, float value)
+    {
+        auto* parameter = processor.getAPVTS().getParameter(id);
+        const float normalised = parameter->convertTo0to1(value);
+        parameter->setValue(normalised);
+
+        ScopedWrapperNotification notification;
+        parameter->sendValueChangedMessageToListeners(normalised);
+    }
+
+    void apply(DriveAudioProcessor& processor, const Combination& c)
+    {
+        setParameter(processor, ParameterIDs::mode, static_cast<float>(c.mode));
+        setParameter(processor, ParameterIDs::oversampling, static_cast<float>(c.oversampling));
+        setParameter(processor, ParameterIDs::adaa, c.adaa ? 1.0f : 0.0f);
+        setParameter(processor, ParameterIDs::ceilingMode, static_cast<float>(c.ceilingMode));
+        setParameter(processor, ParameterIDs::autoGain, c.autoGain ? 1.0f : 0.0f);
+        setParameter(processor, ParameterIDs::bypass, c.bypass ? 1.0f : 0.0f);
+        setParameter(processor, ParameterIDs::adaptiveQuality, c.adaptiveQuality ? 1.0f : 0.0f);
+    }
+
+    /** Moves every continuous parameter, so smoothing and coefficient updates run. */
+    void automate(DriveAudioProcessor& processor, juce::Random& random)
+    {
+        setParameter(processor, ParameterIDs::drive, random.nextFloat() * 100.0f);
+        setParameter(processor, ParameterIDs::pressure, random.nextFloat() * 100.0f);
+        setParameter(processor, ParameterIDs::tone, random.nextFloat() * 200.0f - 100.0f);
+        setParameter(processor, ParameterIDs::mix, random.nextFloat() * 100.0f);
+        setParameter(processor, ParameterIDs::output, random.nextFloat() * 36.0f - 24.0f);
+        setParameter(processor, ParameterIDs::attack, random.nextFloat() * 200.0f - 100.0f);
+        setParameter(processor, ParameterIDs::sustain, random.nextFloat() * 200.0f - 100.0f);
+        setParameter(processor, ParameterIDs::sidechainHp, 20.0f + random.nextFloat() * 480.0f);
+        setParameter(processor, ParameterIDs::stereoWidth, random.nextFloat() * 200.0f);
+        setParameter(processor, ParameterIDs::ceiling, random.nextFloat() * -12.0f);
+    }
+
+    void fillNoise(juce::AudioBuffer<float>& buffer, int numSamples, juce::Random& random, bool identicalChannels)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            if (ch > 0 && identicalChannels)
+            {
+                buffer.copyFrom(ch, 0, buffer, 0, 0, numSamples);
+                continue;
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.8f);
+        }
+    }
+
+    std::vector<Combination> allCombinations()
+    {
+        std::vector<Combination> result;
+        for (int mode = 0; mode < 3; ++mode)
+            for (int oversampling = 0; oversampling <= ChannelStrip::kOversamplingStages; ++oversampling)
+                for (int adaa = 0; adaa < 2; ++adaa)
+                    for (int ceilingMode = 0; ceilingMode < 3; ++ceilingMode)
+                        for (int autoGain = 0; autoGain < 2; ++autoGain)
+                            for (int bypass = 0; bypass < 2; ++bypass)
+                                for (int adaptive = 0; adaptive < 2; ++adaptive)
+                                    for (int viaState = 0; viaState < 2; ++viaState)
+                                        for (int identical = 0; identical < 2; ++identical)
+                                            result.push_back({ mode, oversampling, adaa != 0, ceilingMode, autoGain != 0,
+                                                               bypass != 0, adaptive != 0, viaState != 0, identical != 0 });
+        return result;
+    }
+
+    /** The combination as a state, with random continuous values, from a processor that isn't checked. */
+    void makeState(DriveAudioProcessor& source, const Combination& c, juce::Random& random, juce::MemoryBlock& destData)
+    {
+        apply(source, c);
+        automate(source, random);
+        source.getStateInformation(destData);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const int blocksPerSize = argc > 1 ? juce::jmax(1, juce::String(argv[1]).getIntValue()) : 4;
+
+    DriveAudioProcessor processor;
+    processor.setNonRealtime(false);
+    processor.setTruePeakMetering(true);  // as with the editor open
+
+    // Builds the states for the via-state combinations
+    DriveAudioProcessor stateSource;
+    juce::MemoryBlock state;
+
+    juce::AudioBuffer<float> buffer(2, kMaxBlockSize);
+    juce::MidiBuffer midi;
+    juce::Random random(42);
+
+    const auto combinations = allCombinations();
+    int failedCombinations = 0;
+    int checkedBlocks = 0;
+
+    std::cout << "Checking " << combinations.size() << " combinations x " << std::size(sampleRates)
+              << " sample rates x " << std::size(blockSizes) << " block sizes"
+              << (DRIVE_RTSAN ? " (RealtimeSanitizer on)" : "") << std::endl;
+
+    for (double sampleRate : sampleRates)
+    {
+        processor.prepareToPlay(sampleRate, kMaxBlockSize);
+
+        // Long enough for the engine to switch to one strip for identical channels
+        const int identicalBlocks = static_cast<int>(std::ceil(kIdenticalSeconds * sampleRate / kMaxBlockSize));
+
+        for (const auto& combination : combinations)
+        {
+            // State loads come from the message thread: outside the checked scope
+            if (combination.viaState)
+            {
+                makeState(stateSource, combination, random, state);
+                processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+            }
+
+            violations.clear();
+            hasFirstViolation = false;
+            bool first = true;
+
+            auto processChecked = [&](int blockSize, bool identicalChannels)
+            {
+                fillNoise(buffer, blockSize, random, identicalChannels);
+
+                // Host-sized view of the buffer; no allocation
+                juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, blockSize);
+
+                {
+                    ScopedAudioCallback scope;
+
+                    // The first block applies the combination (or picks up its snapshot)
+                    if (first && !combination.viaState)
+                        apply(processor, combination);
+                    else if (!first)
+                        automate(processor, random);
+
+                    processor.processBlock(block, midi);
+                }
+
+                first = false;
+                ++checkedBlocks;
+            };
+
+            if (combination.identicalChannels)
+                for (int b = 0; b < identicalBlocks; ++b)
+                    processChecked(kMaxBlockSize, true);
+
+            for (int blockSize : blockSizes)
+                for (int b = 0; b < blocksPerSize; ++b)
+                    processChecked(blockSize, false);
+
+            if (violations.total() > 0)
+            {
+                ++failedCombinations;
+                std::cout << "FAIL " << sampleRate << " Hz " << combination.getName()
+                          << ": " << violations.allocations.load() << " allocations, "
+                          << violations.deallocations.load() << " deallocations, "
+                          << violations.locks.load() << " lock waits, "
+                          << violations.syscalls.load() << " blocking syscalls" << std::endl;
+
+                if (failedCombinations == 1)
+                    std::cout << "First violation: " << firstViolation << std::endl;
+            }
+        }
+
+        processor.releaseResources();
+    }
+
+    std::cout << checkedBlocks << " blocks checked, "
+              << failedCombinations << " combinations with violations" << std::endl;
+
+    return failedCombinations > 0 ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+// Compares save/load times of the legacy XML state path (ValueTree -> XML
+// and back through replaceState, as the plugin did before the binary format)
+// and the binary state format.
+// Simulates a session template with many DRIVE instances, and prints the
+// per-instance memory report (owned vs process-wide shared data).
+//
+// Usage: DriveStateBenchmark [numInstances] [numIterations]
+
+#include "../Source/PluginProcessor.h"
+#include "../Source/StateSerializer.h"
+
+#include <iostream>
+
+namespace
+{
+    struct Result
+    {
+        double saveMs = 0.0;
+        double loadMs = 0.0;
+        size_t bytesPerInstance = 0;
+    };
+
+    template <typename SaveFn, typename LoadFn>
+    Result run(juce::OwnedArray<DriveAudioProcessor>& instances, int numIterations, SaveFn&& save, LoadFn&& load)
+    {
+        Result result;
+        std::vector<juce::MemoryBlock> blobs(static_cast<size_t>(instances.size()));
+
+        for (int it = 0; it < numIterations; ++it)
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+            for (int i = 0; i < instances.size(); ++i)
+                save(*instances[i], blobs[static_cast<size_t>(i)]);
+            auto mid = juce::Time::getHighResolutionTicks();
+            for (int i = 0; i < instances.size(); ++i)
+                load(*instances[i], blobs[static_cast<size_t>(i)]);
+            auto end = juce::Time::getHighResolutionTicks();
+
+            result.saveMs += juce::Time::highResolutionTicksToSeconds(mid - start) * 1000.0;
+            result.loadMs += juce::Time::highResolutionTicksToSeconds(end - mid) * 1000.0;
+        }
+
+        result.saveMs /= numIterations;
+        result.loadMs /= numIterations;
+        result.bytesPerInstance = blobs.empty() ? 0 : blobs.front().getSize();
+        return result;
+    }
+
+    void print(const char* name, const Result& r, int numInstances)
+    {
+        std::cout << name
+                  << "  save " << juce::String(r.saveMs, 3) << " ms"
+                  << "  load " << juce::String(r.loadMs, 3) << " ms"
+                  << "  (" << juce::String(r.loadMs * 1000.0 / numInstances, 2) << " us/instance load)"
+                  << "  " << r.bytesPerInstance << " bytes/instance" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const int numInstances = argc > 1 ? juce::jmax(1, juce::String(argv[1]).getIntValue()) : 150;
+    const int numIterations = argc > 2 ? juce::jmax(1, juce::String(argv[2]).getIntValue()) : 20;
+
+    juce::OwnedArray<DriveAudioProcessor> instances;
+    juce::Random random(1234);
+
+    const auto createStart = juce::Time::getHighResolutionTicks();
+    for (int i = 0; i < numInstances; ++i)
+        instances.add(new DriveAudioProcessor());
+    const double createMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - createStart) * 1000.0;
+
+    for (auto* p : instances)
+        for (auto* param : p->getParameters())
+            param->setValueNotifyingHost(random.nextFloat());
+
+    std::cout << "State benchmark: " << numInstances << " instances, " << numIterations << " iterations" << std::endl;
+
+    const auto memory = instances.getFirst()->getMemoryReport();
+    std::cout << "Create " << juce::String(createMs, 3) << " ms"
+              << "  instance " << memory.instanceBytes << " bytes"
+              << "  shared " << memory.sharedBytes << " bytes x " << memory.sharingInstances << " instances"
+              << "  (" << memory.savedBytes << " bytes saved)" << std::endl;
+
+    // The pre-binary getStateInformation/setStateInformation
+    const auto xml = run(instances, numIterations,
+        [](DriveAudioProcessor& p, juce::MemoryBlock& mb) { StateSerializer::writeXml(p.getAPVTS(), mb); },
+        [](DriveAudioProcessor& p, const juce::MemoryBlock& mb) {
+            std::unique_ptr<juce::XmlElement> element(
+                juce::AudioProcessor::getXmlFromBinary(mb.getData(), static_cast<int>(mb.getSize())));
+            if (element != nullptr && element->hasTagName(p.getAPVTS().state.getType()))
+                p.getAPVTS().replaceState(juce::ValueTree::fromXml(*element));
+        });
+
+    const auto binary = run(instances, numIterations,
+        [](DriveAudioProcessor& p, juce::MemoryBlock& mb) { p.getStateInformation(mb); },
+        [](DriveAudioProcessor& p, const juce::MemoryBlock& mb) {
+            p.setStateInformation(mb.getData(), static_cast<int>(mb.getSize()));
+        });
+
+    print("XML   ", xml, numInstances);
+    print("Binary", binary, numInstances);
+
+    if (binary.loadMs > 0.0)
+        std::cout << "Load speedup: " << juce::String(xml.loadMs / binary.loadMs, 1) << "x" << std::endl;
+
+    return 0;
+}
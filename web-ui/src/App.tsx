@@ -7,6 +7,9 @@ import { ModeSelector } from './components/ModeSelector'
 import { SmallKnob } from './components/SmallKnob'
 import { ToggleSwitch } from './components/ToggleSwitch'
 import { PresetSelector } from './components/PresetSelector'
+import { SanitizerStatus } from './components/SanitizerStatus'
+import { EngineInfo } from './components/EngineInfo'
+import { SettingsPanel } from './components/SettingsPanel'
 import { ActivationScreen } from './components/ActivationScreen'
 import { AudioProvider } from './context/AudioContext'
 import { useToggleParam } from './hooks/useJuceParam'
@@ -40,6 +43,7 @@ function PluginUI() {
           DRIVE
         </h1>
         <div className="title-underline" />
+        <SanitizerStatus />
       </header>
 
       {/* Main content */}
@@ -70,6 +74,9 @@ function PluginUI() {
         <PresetSelector />
       </div>
 
+      {/* Output ceiling and quality settings - top right */}
+      <SettingsPanel />
+
       {/* Footer with controls */}
       <footer className="plugin-footer">
         <ModeSelector
@@ -105,6 +112,8 @@ function PluginUI() {
 
         <ToggleSwitch paramId="autoGain" label="AUTO GAIN" color="#ff5522" />
       </footer>
+
+      <EngineInfo />
     </div>
   )
 }
@@ -13,6 +13,7 @@ interface ActivationInfo {
 interface ActivationState {
   isConfigured: boolean
   isActivated: boolean
+  isPending?: boolean
   info?: ActivationInfo
 }
 
@@ -51,6 +52,10 @@ export function ActivationScreen({ onActivated }: { onActivated: () => void }) {
         setActivationInfo(state.info)
         setScreenState('success')
         setTimeout(onActivated, 1500)
+      } else if (state.isPending) {
+        // License check still starting in the background; another
+        // activationState follows when it finishes
+        setScreenState('checking')
       } else {
         setScreenState('input')
       }
@@ -86,6 +91,10 @@ export function ActivationScreen({ onActivated }: { onActivated: () => void }) {
           setErrorMessage('Server error. Please try again later.')
           setScreenState('error')
           break
+        case 'pending':
+          setErrorMessage('License check is still starting. Please try again in a moment.')
+          setScreenState('error')
+          break
         default:
           setErrorMessage('Activation failed. Please try again.')
           setScreenState('error')
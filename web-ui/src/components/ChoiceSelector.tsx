@@ -0,0 +1,32 @@
+import { useComboParam } from '../hooks/useJuceParam'
+
+interface ChoiceSelectorProps {
+  paramId: string
+  label: string
+  // Button captions, one per choice (the parameter's own names are longer)
+  options: string[]
+}
+
+/**
+ * Compact segmented selector for a choice parameter.
+ */
+export function ChoiceSelector({ paramId, label, options }: ChoiceSelectorProps) {
+  const { index, setIndex } = useComboParam(paramId)
+
+  return (
+    <div className="choice-selector">
+      <span className="choice-label">{label}</span>
+      <div className="choice-buttons">
+        {options.map((option, idx) => (
+          <button
+            key={option}
+            className={`choice-button ${index === idx ? 'active' : ''}`}
+            onClick={() => setIndex(idx)}
+          >
+            {option}
+          </button>
+        ))}
+      </div>
+    </div>
+  )
+}
@@ -0,0 +1,49 @@
+import { useState, useEffect } from 'react'
+import { addCustomEventListener, emitEvent } from '../lib/juce-bridge'
+
+interface EngineInfoData {
+  kernelIsa?: string
+  oversampling?: number
+  adaa?: boolean
+  adaptiveQuality?: boolean
+  qualityReduced?: boolean
+}
+
+/**
+ * Shows which CPU kernel path (generic / sse41 / avx2 / avx512) the DSP is
+ * running, as selected by the plugin at startup, and the saturation's
+ * current quality tier (oversampling factor, ADAA). With adaptive quality on
+ * the tier follows the CPU load, and is highlighted while it is below the
+ * chosen oversampling.
+ */
+export function EngineInfo() {
+  const [info, setInfo] = useState<EngineInfoData | null>(null)
+
+  useEffect(() => {
+    const unsubscribe = addCustomEventListener('engineInfo', (eventData: unknown) => {
+      setInfo(eventData as EngineInfoData)
+    })
+
+    emitEvent('requestEngineInfo', {})
+
+    return unsubscribe
+  }, [])
+
+  if (!info?.kernelIsa) {
+    return null
+  }
+
+  const tier = info.oversampling
+    ? `${info.oversampling}X${info.adaa ? ' ADAA' : ''}${info.adaptiveQuality ? ' AUTO' : ''}`
+    : null
+
+  return (
+    <div
+      className={`engine-info${info.qualityReduced ? ' engine-info-reduced' : ''}`}
+      title="DSP kernel instruction set / saturation quality"
+    >
+      {info.kernelIsa.toUpperCase()}
+      {tier && ` · ${tier}`}
+    </div>
+  )
+}
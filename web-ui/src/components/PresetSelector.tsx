@@ -1,5 +1,12 @@
 import { useState, useCallback, useRef, useEffect } from 'react'
-import { getSliderState, getComboBoxState, getToggleState } from '../lib/juce-bridge'
+import {
+  getSliderState,
+  getComboBoxState,
+  getToggleState,
+  addCustomEventListener,
+  emitEvent,
+  isInJuceWebView,
+} from '../lib/juce-bridge'
 
 interface Preset {
   name: string
@@ -16,6 +23,8 @@ interface Preset {
   }
 }
 
+// Built-in list used when running outside the plugin (browser dev server).
+// Inside the plugin, presets come from the native preset library.
 const PRESETS: Preset[] = [
   {
     name: 'Init',
@@ -63,10 +72,70 @@ const PRESETS: Preset[] = [
   }
 ]
 
+// Native presets are identified by their library key (stable across rescans)
+interface NativePreset {
+  id: string
+  name: string
+  tags: string
+  factory: boolean
+}
+
+interface PresetResults {
+  requestId: number
+  offset: number
+  total: number
+  current: string
+  presets: NativePreset[]
+}
+
+// Presets are fetched from the native library in pages while scrolling
+const PAGE_SIZE = 200
+
+function applyBuiltInPreset(preset: Preset) {
+  const { values } = preset
+
+  // Apply all parameter values
+  // Sliders expect normalized 0-1 values, need to convert from display values
+
+  // Drive: 0-100 -> 0-1
+  getSliderState('drive').setNormalisedValue(values.drive / 100)
+
+  // Pressure: 0-100 -> 0-1
+  getSliderState('pressure').setNormalisedValue(values.pressure / 100)
+
+  // Tone: -100 to +100 -> 0-1 (bipolar, 0 = 0.5)
+  getSliderState('tone').setNormalisedValue((values.tone + 100) / 200)
+
+  // Mix: 0-100 -> 0-1
+  getSliderState('mix').setNormalisedValue(values.mix / 100)
+
+  // Output: -24 to +12 dB -> 0-1
+  getSliderState('output').setNormalisedValue((values.output + 24) / 36)
+
+  // Mode: 0, 1, 2 -> setChoiceIndex
+  getComboBoxState('mode').setChoiceIndex(values.mode)
+
+  // Attack: -100 to +100 -> 0-1 (bipolar)
+  getSliderState('attack').setNormalisedValue((values.attack + 100) / 200)
+
+  // Sustain: -100 to +100 -> 0-1 (bipolar)
+  getSliderState('sustain').setNormalisedValue((values.sustain + 100) / 200)
+
+  // Auto Gain: boolean
+  getToggleState('autoGain').setValue(values.autoGain)
+}
+
 export function PresetSelector() {
+  const isNative = isInJuceWebView()
   const [isOpen, setIsOpen] = useState(false)
-  const [currentPreset, setCurrentPreset] = useState(0)
+  const [currentPreset, setCurrentPreset] = useState('0')
+  const [currentName, setCurrentName] = useState(PRESETS[0].name)
+  const [search, setSearch] = useState('')
+  const [nativePresets, setNativePresets] = useState<NativePreset[]>([])
+  const [total, setTotal] = useState(PRESETS.length)
   const dropdownRef = useRef<HTMLDivElement>(null)
+  const requestIdRef = useRef(0)
+  const loadingRef = useRef(false)
 
   // Close dropdown when clicking outside
   useEffect(() => {
@@ -79,55 +148,89 @@ export function PresetSelector() {
     return () => document.removeEventListener('mousedown', handleClickOutside)
   }, [])
 
-  const applyPreset = useCallback((index: number) => {
-    const preset = PRESETS[index]
-    if (!preset) return
-
-    const { values } = preset
-
-    // Apply all parameter values
-    // Sliders expect normalized 0-1 values, need to convert from display values
+  const requestPage = useCallback((query: string, offset: number) => {
+    loadingRef.current = true
+    emitEvent('queryPresets', { requestId: requestIdRef.current, query, offset, limit: PAGE_SIZE })
+  }, [])
 
-    // Drive: 0-100 -> 0-1
-    getSliderState('drive').setNormalisedValue(values.drive / 100)
+  // Native library responses
+  useEffect(() => {
+    if (!isNative) return
 
-    // Pressure: 0-100 -> 0-1
-    getSliderState('pressure').setNormalisedValue(values.pressure / 100)
+    const unsubResults = addCustomEventListener('presetResults', (data: unknown) => {
+      const d = data as PresetResults
+      if (d.requestId !== requestIdRef.current) return // stale query
 
-    // Tone: -100 to +100 -> 0-1 (bipolar, 0 = 0.5)
-    getSliderState('tone').setNormalisedValue((values.tone + 100) / 200)
+      loadingRef.current = false
+      setTotal(d.total)
+      setCurrentPreset(d.current)
+      setNativePresets(prev => (d.offset === 0 ? d.presets : [...prev, ...d.presets]))
+    })
 
-    // Mix: 0-100 -> 0-1
-    getSliderState('mix').setNormalisedValue(values.mix / 100)
+    const unsubLoaded = addCustomEventListener('presetLoaded', (data: unknown) => {
+      const d = data as { id: string; name: string }
+      setCurrentPreset(d.id)
+      setCurrentName(d.name)
+    })
 
-    // Output: -24 to +12 dB -> 0-1
-    getSliderState('output').setNormalisedValue((values.output + 24) / 36)
+    const unsubChanged = addCustomEventListener('presetLibraryChanged', () => {
+      requestIdRef.current++
+      requestPage(search, 0)
+    })
 
-    // Mode: 0, 1, 2 -> setChoiceIndex
-    getComboBoxState('mode').setChoiceIndex(values.mode)
+    return () => {
+      unsubResults()
+      unsubLoaded()
+      unsubChanged()
+    }
+  }, [isNative, search, requestPage])
 
-    // Attack: -100 to +100 -> 0-1 (bipolar)
-    getSliderState('attack').setNormalisedValue((values.attack + 100) / 200)
+  // New query whenever the search text changes
+  useEffect(() => {
+    if (!isNative) return
+    requestIdRef.current++
+    requestPage(search, 0)
+  }, [isNative, search, requestPage])
 
-    // Sustain: -100 to +100 -> 0-1 (bipolar)
-    getSliderState('sustain').setNormalisedValue((values.sustain + 100) / 200)
+  const applyPreset = useCallback((id: string) => {
+    if (isNative) {
+      emitEvent('loadPreset', { id })
+    } else {
+      const preset = PRESETS[Number(id)]
+      if (!preset) return
+      applyBuiltInPreset(preset)
+      setCurrentPreset(id)
+      setCurrentName(preset.name)
+    }
+    setIsOpen(false)
+  }, [isNative])
 
-    // Auto Gain: boolean
-    getToggleState('autoGain').setValue(values.autoGain)
+  // Prev/next step through the unfiltered library. Natively the plugin
+  // steps from the current preset's key, since positions shift on rescans
+  const stepPreset = useCallback((delta: number) => {
+    if (isNative) {
+      emitEvent('stepPreset', { delta })
+      return
+    }
+    const count = PRESETS.length
+    applyPreset(String((Number(currentPreset) + delta + count) % count))
+  }, [isNative, currentPreset, applyPreset])
 
-    setCurrentPreset(index)
-    setIsOpen(false)
-  }, [])
+  const handlePrev = useCallback(() => stepPreset(-1), [stepPreset])
+  const handleNext = useCallback(() => stepPreset(1), [stepPreset])
 
-  const handlePrev = useCallback(() => {
-    const newIndex = currentPreset > 0 ? currentPreset - 1 : PRESETS.length - 1
-    applyPreset(newIndex)
-  }, [currentPreset, applyPreset])
+  const handleScroll = useCallback((e: React.UIEvent<HTMLDivElement>) => {
+    const el = e.currentTarget
+    const nearBottom = el.scrollTop + el.clientHeight >= el.scrollHeight - 40
+    if (isNative && nearBottom && !loadingRef.current && nativePresets.length < total) {
+      requestPage(search, nativePresets.length)
+    }
+  }, [isNative, nativePresets.length, total, search, requestPage])
 
-  const handleNext = useCallback(() => {
-    const newIndex = currentPreset < PRESETS.length - 1 ? currentPreset + 1 : 0
-    applyPreset(newIndex)
-  }, [currentPreset, applyPreset])
+  const items = isNative
+    ? nativePresets.map(p => ({ id: p.id, name: p.name }))
+    : PRESETS.map((p, index) => ({ id: String(index), name: p.name }))
+        .filter(p => p.name.toLowerCase().includes(search.toLowerCase()))
 
   return (
     <div className="preset-selector" ref={dropdownRef}>
@@ -138,7 +241,7 @@ export function PresetSelector() {
       </button>
 
       <button className="preset-name" onClick={() => setIsOpen(!isOpen)}>
-        {PRESETS[currentPreset]?.name || 'Init'}
+        {currentName || 'Init'}
       </button>
 
       <button className="preset-nav next" onClick={handleNext}>
@@ -149,15 +252,25 @@ export function PresetSelector() {
 
       {isOpen && (
         <div className="preset-dropdown">
-          {PRESETS.map((preset, index) => (
-            <button
-              key={preset.name}
-              className={`preset-item ${index === currentPreset ? 'active' : ''}`}
-              onClick={() => applyPreset(index)}
-            >
-              {preset.name}
-            </button>
-          ))}
+          <input
+            className="preset-search"
+            type="text"
+            placeholder="Search"
+            value={search}
+            onChange={e => setSearch(e.target.value)}
+            autoFocus
+          />
+          <div className="preset-list" onScroll={handleScroll}>
+            {items.map(preset => (
+              <button
+                key={preset.id}
+                className={`preset-item ${preset.id === currentPreset ? 'active' : ''}`}
+                onClick={() => applyPreset(preset.id)}
+              >
+                {preset.name}
+              </button>
+            ))}
+          </div>
         </div>
       )}
     </div>
@@ -0,0 +1,57 @@
+import { useState, useEffect, useCallback } from 'react'
+import { addCustomEventListener, emitEvent } from '../lib/juce-bridge'
+
+interface SanitizerCounts {
+  nonFinite: number
+  denormals: number
+  resets: number
+}
+
+/**
+ * Shows how many bad input samples the plugin had to repair (NaN/Inf,
+ * denormals) and how often internal state was reset. Hidden while all
+ * counters are zero; click to reset them.
+ */
+export function SanitizerStatus() {
+  const [counts, setCounts] = useState<SanitizerCounts>({ nonFinite: 0, denormals: 0, resets: 0 })
+
+  useEffect(() => {
+    const unsubscribe = addCustomEventListener('visualizerData', (eventData: unknown) => {
+      const d = eventData as { sanitizedNonFinite?: number; sanitizedDenormals?: number; stateResets?: number }
+      const next = {
+        nonFinite: d.sanitizedNonFinite ?? 0,
+        denormals: d.sanitizedDenormals ?? 0,
+        resets: d.stateResets ?? 0
+      }
+
+      // visualizerData arrives at 60fps - only re-render on change
+      setCounts(prev =>
+        prev.nonFinite === next.nonFinite && prev.denormals === next.denormals && prev.resets === next.resets
+          ? prev
+          : next
+      )
+    })
+
+    return unsubscribe
+  }, [])
+
+  const handleReset = useCallback(() => {
+    emitEvent('resetSanitizerCounters', {})
+  }, [])
+
+  if (counts.nonFinite === 0 && counts.denormals === 0 && counts.resets === 0) {
+    return null
+  }
+
+  return (
+    <div
+      className="sanitizer-status"
+      onClick={handleReset}
+      title="Bad samples received from upstream. Click to reset."
+    >
+      {counts.nonFinite > 0 && <span>NaN/Inf {counts.nonFinite}</span>}
+      {counts.denormals > 0 && <span>DENORMAL {counts.denormals}</span>}
+      {counts.resets > 0 && <span>RESET {counts.resets}</span>}
+    </div>
+  )
+}
@@ -0,0 +1,50 @@
+import { useState, useRef, useEffect } from 'react'
+import { ChoiceSelector } from './ChoiceSelector'
+import { HorizontalSlider } from './HorizontalSlider'
+import { ToggleSwitch } from './ToggleSwitch'
+
+/**
+ * Gear button with a drop-down of the less frequently used settings:
+ * the true-peak output ceiling and the saturator's anti-aliasing and
+ * adaptive quality.
+ */
+export function SettingsPanel() {
+  const [isOpen, setIsOpen] = useState(false)
+  const panelRef = useRef<HTMLDivElement>(null)
+
+  // Close when clicking outside
+  useEffect(() => {
+    const handleClickOutside = (e: MouseEvent) => {
+      if (panelRef.current && !panelRef.current.contains(e.target as Node)) {
+        setIsOpen(false)
+      }
+    }
+    document.addEventListener('mousedown', handleClickOutside)
+    return () => document.removeEventListener('mousedown', handleClickOutside)
+  }, [])
+
+  return (
+    <div className="settings-container" ref={panelRef}>
+      <button className={`settings-button ${isOpen ? 'open' : ''}`} onClick={() => setIsOpen(!isOpen)}>
+        <svg viewBox="0 0 24 24" fill="none" stroke="currentColor" strokeWidth="1.5">
+          <circle cx="12" cy="12" r="3" />
+          <path d="M12 2v3M12 19v3M2 12h3M19 12h3M4.9 4.9l2.1 2.1M17 17l2.1 2.1M4.9 19.1l2.1-2.1M17 7l2.1-2.1" />
+        </svg>
+      </button>
+
+      {isOpen && (
+        <div className="settings-panel">
+          <div className="settings-section">
+            <ChoiceSelector paramId="ceilingMode" label="CEILING" options={['OFF', 'CLIP', 'LIMIT']} />
+            <HorizontalSlider paramId="ceiling" label="LEVEL" color="#aa8877" width={160} unit="dBTP" displayMin={-12} displayMax={0} />
+          </div>
+          <div className="settings-section">
+            <ChoiceSelector paramId="oversampling" label="OVERSAMPLING" options={['1X', '2X', '4X']} />
+            <ToggleSwitch paramId="adaa" label="ADAA" color="#aa8877" />
+            <ToggleSwitch paramId="adaptiveQuality" label="AUTO" color="#aa8877" />
+          </div>
+        </div>
+      )}
+    </div>
+  )
+}
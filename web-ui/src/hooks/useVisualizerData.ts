@@ -5,6 +5,10 @@ export interface VisualizerData {
   rms: number
   peak: number
   envelope: number
+  truePeak: number
+  outputRms: number
+  outputPeak: number
+  outputTruePeak: number
 }
 
 /**
@@ -14,7 +18,11 @@ export function useVisualizerData(): VisualizerData {
   const [data, setData] = useState<VisualizerData>({
     rms: 0,
     peak: 0,
-    envelope: 0
+    envelope: 0,
+    truePeak: 0,
+    outputRms: 0,
+    outputPeak: 0,
+    outputTruePeak: 0
   })
 
   useEffect(() => {
@@ -23,7 +31,11 @@ export function useVisualizerData(): VisualizerData {
       setData({
         rms: d.rms ?? 0,
         peak: d.peak ?? 0,
-        envelope: d.envelope ?? 0
+        envelope: d.envelope ?? 0,
+        truePeak: d.truePeak ?? 0,
+        outputRms: d.outputRms ?? 0,
+        outputPeak: d.outputPeak ?? 0,
+        outputTruePeak: d.outputTruePeak ?? 0
       })
     })
 
@@ -84,6 +84,50 @@ export function isInJuceWebView(): boolean {
 // Alias for backwards compatibility
 export const isJuceEnvironment = isInJuceWebView;
 
+// ==============================================================================
+// Relay Update Coalescing
+// ==============================================================================
+
+/*
+ * A knob drag produces a value per pointer event, often several per frame.
+ * Slider values are queued per relay and sent once per animation frame, so
+ * only the latest value of each frame crosses the bridge. The C++ side
+ * (CoalescedSliderAttachment) coalesces again before writing to the host.
+ */
+const pendingRelayUpdates = new Map<string, () => void>();
+let relayFlushScheduled = false;
+
+function flushRelayUpdates(): void {
+  relayFlushScheduled = false;
+  const updates = Array.from(pendingRelayUpdates.values());
+  pendingRelayUpdates.clear();
+  for (const send of updates) {
+    send();
+  }
+}
+
+function queueRelayUpdate(identifier: string, send: () => void): void {
+  pendingRelayUpdates.set(identifier, send);
+  if (relayFlushScheduled) return;
+
+  relayFlushScheduled = true;
+  // rAF doesn't fire while the page is hidden, so fall back to a timer
+  if (typeof requestAnimationFrame === 'function' && !document.hidden) {
+    requestAnimationFrame(flushRelayUpdates);
+  } else {
+    setTimeout(flushRelayUpdates, 16);
+  }
+}
+
+/** Sends the queued update for one relay now, if there is one */
+function flushRelayUpdate(identifier: string): void {
+  const send = pendingRelayUpdates.get(identifier);
+  if (send === undefined) return;
+
+  pendingRelayUpdates.delete(identifier);
+  send();
+}
+
 // ==============================================================================
 // SliderState - Continuous Parameter Control
 // ==============================================================================
@@ -147,30 +191,26 @@ export class SliderState {
     }
   }
 
-  /** Set value from 0-1 normalized range */
+  /** Set value from 0-1 normalized range. Sent to C++ on the next animation frame. */
   setNormalisedValue(newValue: number): void {
-    console.log(`[SliderState ${this.name}] setNormalisedValue called with: ${newValue}`);
-    console.log(`[SliderState ${this.name}] properties:`, this.properties);
-
     this.scaledValue = this.snapToLegalValue(
       this.normalisedToScaledValue(newValue)
     );
 
-    console.log(`[SliderState ${this.name}] converted to scaled: ${this.scaledValue}`);
-    console.log(`[SliderState ${this.name}] isInJuceWebView: ${isInJuceWebView()}`);
-
     if (isInJuceWebView()) {
-      console.log(`[SliderState ${this.name}] emitting event to: ${this.identifier}`);
-      window.__JUCE__!.backend.emitEvent(this.identifier, {
-        eventType: BasicControl_valueChangedEventId,
-        value: this.scaledValue,
-      });
+      queueRelayUpdate(this.identifier, () =>
+        window.__JUCE__!.backend.emitEvent(this.identifier, {
+          eventType: BasicControl_valueChangedEventId,
+          value: this.scaledValue,
+        })
+      );
     }
   }
 
   /** Call when user starts dragging (for undo grouping) */
   sliderDragStarted(): void {
     if (isInJuceWebView()) {
+      flushRelayUpdate(this.identifier);
       window.__JUCE__!.backend.emitEvent(this.identifier, {
         eventType: SliderControl_sliderDragStartedEventId,
       });
@@ -180,6 +220,8 @@ export class SliderState {
   /** Call when user stops dragging (for undo grouping) */
   sliderDragEnded(): void {
     if (isInJuceWebView()) {
+      // The last value of the drag must arrive before the gesture ends
+      flushRelayUpdate(this.identifier);
       window.__JUCE__!.backend.emitEvent(this.identifier, {
         eventType: SliderControl_sliderDragEndedEventId,
       });
@@ -187,10 +229,11 @@ export class SliderState {
   }
 
   private handleEvent(event: Record<string, unknown>): void {
-    console.log(`[SliderState ${this.name}] handleEvent:`, event);
     if (event.eventType === BasicControl_valueChangedEventId) {
+      // An echo of an older value would make the knob jump back mid-drag
+      if (pendingRelayUpdates.has(this.identifier)) return;
+
       this.scaledValue = event.value as number;
-      console.log(`[SliderState ${this.name}] value updated to: ${this.scaledValue}`);
       this.valueChangedEvent.callListeners();
     }
     if (event.eventType === BasicControl_propertiesChangedId) {